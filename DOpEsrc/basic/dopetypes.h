@@ -127,12 +127,24 @@ namespace DOpE
      * only_recent      Only keep a copy of the most recent timestep
      *                  (Only useful for pure forward runs and
      *                   Pseudo-Timestepping methods)
+     * checkpointing    Keeps only a bounded number of time steps in the
+     *                  main memory, the others are recomputed from
+     *                  the nearest checkpoint when needed
+     *                  (Only for StateVectors of the InstatReducedProblem)
+     * mapped_file      Like store_on_disc, but all timesteps share one
+     *                  memory mapped file with a fixed offset per timestep
+     *                  (Only for serial vectors)
+     * compressed       Like store_on_disc, but the unused timesteps are
+     *                  kept compressed in the main memory
      */
     enum VectorStorageType
     {
       fullmem,
       store_on_disc,
-      only_recent
+      only_recent,
+      checkpointing,
+      mapped_file,
+      compressed
     };
 
     /**
@@ -152,6 +164,24 @@ namespace DOpE
       local_constraint
     };
 
+    /**
+     * An enum that describes the numbering of the degrees of freedom
+     * set up by the SpaceTimeHandlers after distribute_dofs.
+     * In all cases the DoFs are sorted by blocks afterwards,
+     * i.e., the numbering given below is used within each block.
+     *
+     * component_wise   Only sort the DoFs by blocks
+     * cuthill_mckee    Cuthill-McKee ordering to reduce the bandwidth
+     * hilbert          Cell-wise ordering along a Hilbert curve through
+     *                  the cell centers to improve the locality
+     */
+    enum DoFRenumberingType
+    {
+      component_wise,
+      cuthill_mckee,
+      hilbert
+    };
+
   }//End of namespace DOpEtypes
 
 
@@ -175,6 +205,12 @@ namespace DOpE
         return "store_on_disc";
       case DOpEtypes::VectorStorageType::only_recent:
         return "only_recent";
+      case DOpEtypes::VectorStorageType::checkpointing:
+        return "checkpointing";
+      case DOpEtypes::VectorStorageType::mapped_file:
+        return "mapped_file";
+      case DOpEtypes::VectorStorageType::compressed:
+        return "compressed";
       default:
       {
         std::stringstream out;
@@ -257,6 +293,29 @@ namespace DOpE
       }
   }
 
+  template <>
+  inline std::string
+  DOpEtypesToString (const DOpEtypes::DoFRenumberingType &t)
+  {
+    switch (t)
+      {
+      case DOpEtypes::DoFRenumberingType::component_wise:
+        return "component_wise";
+      case DOpEtypes::DoFRenumberingType::cuthill_mckee:
+        return "cuthill_mckee";
+      case DOpEtypes::DoFRenumberingType::hilbert:
+        return "hilbert";
+      default:
+      {
+        std::stringstream out;
+        out << "Unknown DOpEtypes::DoFRenumberingType" << std::endl;
+        out << "Code given is " << t << std::endl;
+        throw DOpEException (out.str (),
+                             "DOpEtypesToString<DOpEtypes::DoFRenumberingType>");
+      }
+      }
+  }
+
 }//End of Namespace DOpE
 
 #endif /* DOPETYPES_H_ */
@@ -98,6 +98,8 @@ namespace DOpE
       sparsitymaker_ = new SparsityMaker<DH, dealdim>(flux_pattern);
 #endif
       user_defined_dof_constr_ = NULL;
+      control_renumbering_ = DOpEtypes::DoFRenumberingType::component_wise;
+      state_renumbering_ = DOpEtypes::DoFRenumberingType::component_wise;
     }
 
     /**
@@ -136,6 +138,8 @@ namespace DOpE
       sparsitymaker_ = new SparsityMaker<DH, dealdim>(flux_pattern);
 #endif
       user_defined_dof_constr_ = NULL;
+      control_renumbering_ = DOpEtypes::DoFRenumberingType::component_wise;
+      state_renumbering_ = DOpEtypes::DoFRenumberingType::component_wise;
     }
 
     /**
@@ -174,6 +178,8 @@ namespace DOpE
       sparsitymaker_ = new SparsityMaker<DH, dealdim>(flux_pattern);
 #endif
       user_defined_dof_constr_ = NULL;
+      control_renumbering_ = DOpEtypes::DoFRenumberingType::component_wise;
+      state_renumbering_ = DOpEtypes::DoFRenumberingType::component_wise;
     }
 
     /**
@@ -214,6 +220,8 @@ namespace DOpE
       sparsitymaker_ = new SparsityMaker<DH, dealdim>(flux_pattern);
 #endif
       user_defined_dof_constr_ = NULL;
+      control_renumbering_ = DOpEtypes::DoFRenumberingType::component_wise;
+      state_renumbering_ = DOpEtypes::DoFRenumberingType::component_wise;
     }
 
     virtual
@@ -259,11 +267,13 @@ namespace DOpE
       control_dof_handler_.distribute_dofs(GetFESystem("control"));
 
 #if dope_dimension > 0
+      STHInternals::RenumberDoFs(
 #if DEAL_II_VERSION_GTE(9,3,0)
-      DoFRenumbering::component_wise (static_cast<dealii::DoFHandler<dopedim, dopedim>&>(control_dof_handler_),control_block_component);
+        static_cast<dealii::DoFHandler<dopedim, dopedim>&>(control_dof_handler_),
 #else
-      DoFRenumbering::component_wise (static_cast<DH<dopedim, dopedim>&>(control_dof_handler_),control_block_component);
+        static_cast<DH<dopedim, dopedim>&>(control_dof_handler_),
 #endif
+        control_renumbering_, control_block_component);
       if (dopedim==dealdim)
         {
           control_hn_constraints_.clear ();
@@ -347,11 +357,13 @@ namespace DOpE
       SpaceTimeHandler<FE, DH, SPARSITYPATTERN, VECTOR, dopedim, dealdim>::SetActiveFEIndicesState(
         state_dof_handler_);
       state_dof_handler_.distribute_dofs(GetFESystem("state"));
+      STHInternals::RenumberDoFs(
 #if DEAL_II_VERSION_GTE(9,3,0)
-      DoFRenumbering::component_wise(static_cast<dealii::DoFHandler<dealdim, dealdim>&>(state_dof_handler_),state_block_component);
+        static_cast<dealii::DoFHandler<dealdim, dealdim>&>(state_dof_handler_),
 #else
-      DoFRenumbering::component_wise(static_cast<DH<dealdim, dealdim>&>(state_dof_handler_),state_block_component);
+        static_cast<DH<dealdim, dealdim>&>(state_dof_handler_),
 #endif
+        state_renumbering_, state_block_component);
 
       state_hn_constraints_.clear();
       state_hn_constraints_.reinit (
@@ -935,6 +947,76 @@ namespace DOpE
       sparse_mkr_dynamic_ = false;
     }
 
+    /******************************************************/
+    /**
+     * Declares the parameters read by SetDoFRenumbering.
+     */
+    static void declare_params(ParameterReader &param_reader)
+    {
+      STHInternals::DeclareDoFRenumberingParams(param_reader);
+    }
+    /**
+     * Sets the numbering of the control and state dofs as given in the
+     * subsection `dof renumbering parameters`.
+     * This function must be called prior to ReInit.
+     */
+    void SetDoFRenumbering(ParameterReader &param_reader)
+    {
+      SetControlDoFRenumbering(STHInternals::GetDoFRenumbering(param_reader,"control"));
+      SetStateDoFRenumbering(STHInternals::GetDoFRenumbering(param_reader,"state"));
+    }
+    /**
+     * Sets the numbering of the control dofs used in ReInit,
+     * see DOpEtypes::DoFRenumberingType. It is only used
+     * if the control is a finite element function (dopedim > 0).
+     * This function must be called prior to ReInit.
+     */
+    void SetControlDoFRenumbering(DOpEtypes::DoFRenumberingType renumbering)
+    {
+      control_renumbering_ = renumbering;
+    }
+    /**
+     * Sets the numbering of the state dofs used in ReInit,
+     * see DOpEtypes::DoFRenumberingType.
+     * This function must be called prior to ReInit.
+     */
+    void SetStateDoFRenumbering(DOpEtypes::DoFRenumberingType renumbering)
+    {
+      state_renumbering_ = renumbering;
+    }
+    /**
+     * Returns the number of dofs, the number of nonzero entries and the
+     * bandwidth of the sparsity pattern of the control dofs (only for dopedim > 0).
+     * Note that this assembles a sparsity pattern.
+     */
+    STHInternals::DoFNumberingStatistics GetControlDoFNumberingStatistics() const
+    {
+      return STHInternals::ComputeDoFNumberingStatistics(control_dof_handler_.GetDEALDoFHandler(), control_dof_constraints_);
+    }
+    /**
+     * Returns the number of dofs, the number of nonzero entries and the
+     * bandwidth of the sparsity pattern of the state dofs, e.g., to compare
+     * different numberings. Note that this assembles a sparsity pattern.
+     */
+    STHInternals::DoFNumberingStatistics GetStateDoFNumberingStatistics() const
+    {
+      return STHInternals::ComputeDoFNumberingStatistics(state_dof_handler_.GetDEALDoFHandler(), state_dof_constraints_);
+    }
+    /**
+     * Writes the statistics of the state and control dofs if they are renumbered.
+     */
+    void PrintDoFNumberingInfos(std::stringstream &out) const override
+    {
+#if dope_dimension > 0
+      if (control_renumbering_ != DOpEtypes::DoFRenumberingType::component_wise)
+        STHInternals::PrintDoFNumberingStatistics("Control", control_renumbering_,
+                                                  GetControlDoFNumberingStatistics(), out);
+#endif
+      if (state_renumbering_ != DOpEtypes::DoFRenumberingType::component_wise)
+        STHInternals::PrintDoFNumberingStatistics("State", state_renumbering_,
+                                                  GetStateDoFNumberingStatistics(), out);
+    }
+
     /******************************************************/
     /**
      * Through this function one can reinitialize the
@@ -965,6 +1047,8 @@ namespace DOpE
     SparsityMaker<DH, dealdim> *sparsitymaker_;
 #endif
     UserDefinedDoFConstraints<DH, dopedim, dealdim> *user_defined_dof_constr_;
+    DOpEtypes::DoFRenumberingType control_renumbering_;
+    DOpEtypes::DoFRenumberingType state_renumbering_;
 
     dealii::Triangulation<dealdim> &triangulation_;
 #if DEAL_II_VERSION_GTE(9,3,0)
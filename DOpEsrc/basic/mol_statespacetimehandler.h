@@ -81,6 +81,7 @@ namespace DOpE
       sparsitymaker_ = new SparsityMaker<DH, dealdim>(flux_pattern);
 #endif
       user_defined_dof_constr_ = NULL;
+      state_renumbering_ = DOpEtypes::DoFRenumberingType::component_wise;
     }
     MethodOfLines_StateSpaceTimeHandler(
       dealii::Triangulation<dealdim> &triangulation, const FE<dealdim, dealdim> &state_fe,
@@ -103,6 +104,7 @@ namespace DOpE
       sparsitymaker_ = new SparsityMaker<DH, dealdim>(flux_pattern);
 #endif
       user_defined_dof_constr_ = NULL;
+      state_renumbering_ = DOpEtypes::DoFRenumberingType::component_wise;
     }
 
     MethodOfLines_StateSpaceTimeHandler(
@@ -124,6 +126,7 @@ namespace DOpE
       sparsitymaker_ = new SparsityMaker<DH, dealdim>(flux_pattern);
 #endif
       user_defined_dof_constr_ = NULL;
+      state_renumbering_ = DOpEtypes::DoFRenumberingType::component_wise;
     }
     MethodOfLines_StateSpaceTimeHandler(
       dealii::Triangulation<dealdim> &triangulation,
@@ -145,6 +148,7 @@ namespace DOpE
       sparsitymaker_ = new SparsityMaker<DH, dealdim>(flux_pattern);
 #endif
       user_defined_dof_constr_ = NULL;
+      state_renumbering_ = DOpEtypes::DoFRenumberingType::component_wise;
     }
 
     virtual
@@ -173,14 +177,13 @@ namespace DOpE
       StateSpaceTimeHandler<FE, DH, SPARSITYPATTERN, VECTOR, dealdim>::SetActiveFEIndicesState(
         state_dof_handler_);
       state_dof_handler_.distribute_dofs(GetFESystem("state"));
-//          DoFRenumbering::Cuthill_McKee(
-//              static_cast<DH<dealdim, dealdim>&>(state_dof_handler_));
-      DoFRenumbering::component_wise(
+      STHInternals::RenumberDoFs(
 #if DEAL_II_VERSION_GTE(9,3,0)
-        static_cast<dealii::DoFHandler<dealdim, dealdim>&>(state_dof_handler_),state_block_component);
+        static_cast<dealii::DoFHandler<dealdim, dealdim>&>(state_dof_handler_),
 #else
-        static_cast<DH<dealdim, dealdim>&>(state_dof_handler_),state_block_component);
+        static_cast<DH<dealdim, dealdim>&>(state_dof_handler_),
 #endif
+        state_renumbering_, state_block_component);
 
       state_hn_constraints_.clear();
       state_hn_constraints_.reinit (
@@ -568,6 +571,50 @@ namespace DOpE
       sparsitymaker_ = &sparsity_maker;
       sparse_mkr_dynamic_ = false;
     }
+    /******************************************************/
+    /**
+     * Declares the parameters read by SetDoFRenumbering.
+     */
+    static void declare_params(ParameterReader &param_reader)
+    {
+      STHInternals::DeclareDoFRenumberingParams(param_reader);
+    }
+    /**
+     * Sets the numbering of the state dofs as given in the
+     * subsection `dof renumbering parameters`.
+     * This function must be called prior to ReInit.
+     */
+    void SetDoFRenumbering(ParameterReader &param_reader)
+    {
+      SetStateDoFRenumbering(STHInternals::GetDoFRenumbering(param_reader,"state"));
+    }
+    /**
+     * Sets the numbering of the state dofs used in ReInit,
+     * see DOpEtypes::DoFRenumberingType.
+     * This function must be called prior to ReInit.
+     */
+    void SetStateDoFRenumbering(DOpEtypes::DoFRenumberingType renumbering)
+    {
+      state_renumbering_ = renumbering;
+    }
+    /**
+     * Returns the number of dofs, the number of nonzero entries and the
+     * bandwidth of the sparsity pattern of the state dofs, e.g., to compare
+     * different numberings. Note that this assembles a sparsity pattern.
+     */
+    STHInternals::DoFNumberingStatistics GetStateDoFNumberingStatistics() const
+    {
+      return STHInternals::ComputeDoFNumberingStatistics(state_dof_handler_.GetDEALDoFHandler(), state_dof_constraints_);
+    }
+    /**
+     * Writes the statistics of the state dofs if they are renumbered.
+     */
+    void PrintDoFNumberingInfos(std::stringstream &out) const override
+    {
+      if (state_renumbering_ != DOpEtypes::DoFRenumberingType::component_wise)
+        STHInternals::PrintDoFNumberingStatistics("State", state_renumbering_,
+                                                  GetStateDoFNumberingStatistics(), out);
+    }
 
   private:
 #if DEAL_II_VERSION_GTE(9,3,0)
@@ -591,6 +638,7 @@ namespace DOpE
 #endif
     UserDefinedDoFConstraints<DH, dealdim> *user_defined_dof_constr_;
     bool sparse_mkr_dynamic_;
+    DOpEtypes::DoFRenumberingType state_renumbering_;
 
     dealii::Triangulation<dealdim> &triangulation_;
 #if DEAL_II_VERSION_GTE(9,3,0)
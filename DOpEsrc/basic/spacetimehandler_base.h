@@ -462,6 +462,14 @@ namespace DOpE
     {
       abort();
     }
+    /**
+     * Writes the number of nonzero entries and the bandwidth of the
+     * sparsity patterns of all dofs that are not numbered component wise,
+     * see DOpEtypes::DoFRenumberingType. Does nothing by default.
+     */
+    virtual void PrintDoFNumberingInfos(std::stringstream &/*out*/) const
+    {
+    }
 
     /**
      * Returns the length of interval_;
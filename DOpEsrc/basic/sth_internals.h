@@ -25,15 +25,25 @@
 #define STH_INTERNALS_H_
 
 #include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <sstream>
+#include <string>
 #include <wrapper/mapping_wrapper.h>
 
+#include <deal.II/base/utilities.h>
 #include <deal.II/dofs/dof_tools.h>
+#include <deal.II/dofs/dof_renumbering.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
 #include <deal.II/fe/mapping_q1.h>
 #include <deal.II/hp/mapping_collection.h>
 #include <deal.II/grid/tria.h>
 #include <deal.II/grid/grid_tools.h>
 
 #include <wrapper/dofhandler_wrapper.h>
+#include <include/parameterreader.h>
+#include <basic/dopetypes.h>
 
 using namespace dealii;
 
@@ -146,6 +156,151 @@ namespace DOpE
         }
     }
 
+    /**
+     * Size and bandwidth of the sparsity pattern of a DoFHandler,
+     * see ComputeDoFNumberingStatistics.
+     */
+    struct DoFNumberingStatistics
+    {
+      unsigned int n_dofs;
+      unsigned int n_nonzero_elements;
+      unsigned int bandwidth;
+    };
+
+    /**
+     * Declares the parameters for the renumbering of the DoFs
+     * in the SpaceTimeHandlers.
+     */
+    inline void
+    DeclareDoFRenumberingParams(ParameterReader &param_reader)
+    {
+      param_reader.SetSubsection("dof renumbering parameters");
+      param_reader.declare_entry("state_renumbering", "component_wise",
+                                 Patterns::Selection("component_wise|cuthill_mckee|hilbert"),
+                                 "Numbering of the state dofs within each block");
+      param_reader.declare_entry("control_renumbering", "component_wise",
+                                 Patterns::Selection("component_wise|cuthill_mckee|hilbert"),
+                                 "Numbering of the control dofs within each block");
+    }
+
+    /**
+     * Reads the renumbering of the dofs of the given type (state or control)
+     * declared in DeclareDoFRenumberingParams.
+     */
+    inline DOpEtypes::DoFRenumberingType
+    GetDoFRenumbering(ParameterReader &param_reader, std::string type)
+    {
+      param_reader.SetSubsection("dof renumbering parameters");
+      std::string name = param_reader.get_string(type+"_renumbering");
+      if (name == "cuthill_mckee")
+        return DOpEtypes::DoFRenumberingType::cuthill_mckee;
+      if (name == "hilbert")
+        return DOpEtypes::DoFRenumberingType::hilbert;
+      return DOpEtypes::DoFRenumberingType::component_wise;
+    }
+
+    /**
+     * Numbers the cells along a Hilbert curve through the cell centers
+     * and renumbers the dofs cell by cell in this order.
+     */
+    template<typename DOFHANDLER>
+    void
+    HilbertRenumbering(DOFHANDLER &dof_handler)
+    {
+#if DEAL_II_VERSION_GTE(9,1,0)
+      const unsigned int dim = DOFHANDLER::dimension;
+      const int bits_per_dim = 64/dim;
+
+      std::vector<typename DOFHANDLER::active_cell_iterator> cells;
+      std::vector<Point<DOFHANDLER::space_dimension> > centers;
+      for (auto cell = dof_handler.begin_active(); cell != dof_handler.end(); ++cell)
+        {
+          cells.push_back(cell);
+          centers.push_back(cell->center());
+        }
+      const auto hilbert_indices
+        = Utilities::inverse_Hilbert_space_filling_curve(centers, bits_per_dim);
+
+      std::vector<std::pair<std::uint64_t, unsigned int> > order(cells.size());
+      for (unsigned int i = 0; i < cells.size(); i++)
+        {
+          order[i].first = Utilities::pack_integers<DOFHANDLER::space_dimension>(hilbert_indices[i], bits_per_dim);
+          order[i].second = i;
+        }
+      std::sort(order.begin(), order.end());
+
+      std::vector<typename DOFHANDLER::active_cell_iterator> ordered_cells(cells.size());
+      for (unsigned int i = 0; i < cells.size(); i++)
+        ordered_cells[i] = cells[order[i].second];
+      DoFRenumbering::cell_wise(dof_handler, ordered_cells);
+#else
+      (void) dof_handler;
+      throw DOpEException("Hilbert renumbering requires deal.II 9.1.0 or newer", "STHInternals::HilbertRenumbering");
+#endif
+    }
+
+    /**
+     * Renumbers the dofs with the given numbering, and sorts them by blocks
+     * afterwards. Since the sort by blocks retains the order within each block,
+     * the chosen numbering is kept within the blocks.
+     */
+    template<typename DOFHANDLER>
+    void
+    RenumberDoFs(DOFHANDLER &dof_handler,
+                 DOpEtypes::DoFRenumberingType renumbering,
+                 const std::vector<unsigned int> &block_component)
+    {
+      switch (renumbering)
+        {
+        case DOpEtypes::DoFRenumberingType::component_wise:
+          break;
+        case DOpEtypes::DoFRenumberingType::cuthill_mckee:
+          DoFRenumbering::Cuthill_McKee(dof_handler);
+          break;
+        case DOpEtypes::DoFRenumberingType::hilbert:
+          HilbertRenumbering(dof_handler);
+          break;
+        default:
+          throw DOpEException("Unknown renumbering "+DOpEtypesToString(renumbering), "STHInternals::RenumberDoFs");
+        }
+      DoFRenumbering::component_wise(dof_handler, block_component);
+    }
+
+    /**
+     * Computes the number of nonzero entries and the bandwidth of the
+     * sparsity pattern of the given dofs, e.g., to compare different
+     * numberings.
+     */
+    template<typename DOFHANDLER, typename CONSTRAINTS>
+    DoFNumberingStatistics
+    ComputeDoFNumberingStatistics(const DOFHANDLER &dof_handler,
+                                  const CONSTRAINTS &constraints)
+    {
+      DynamicSparsityPattern dsp(dof_handler.n_dofs(), dof_handler.n_dofs());
+      DoFTools::make_sparsity_pattern(dof_handler, dsp, constraints, false);
+
+      DoFNumberingStatistics statistics;
+      statistics.n_dofs = dof_handler.n_dofs();
+      statistics.n_nonzero_elements = dsp.n_nonzero_elements();
+      statistics.bandwidth = dsp.bandwidth();
+      return statistics;
+    }
+
+    /**
+     * Writes the statistics of the dofs `name` computed with
+     * ComputeDoFNumberingStatistics together with the used numbering.
+     */
+    inline void
+    PrintDoFNumberingStatistics(std::string name,
+                                DOpEtypes::DoFRenumberingType renumbering,
+                                const DoFNumberingStatistics &statistics,
+                                std::stringstream &out)
+    {
+      out << "\t" << name << " numbering: " << DOpEtypesToString(renumbering)
+          << ", nonzeros: " << statistics.n_nonzero_elements
+          << ", bandwidth: " << statistics.bandwidth << std::endl;
+    }
+
   }//End of namespace STHInternals
 }
 
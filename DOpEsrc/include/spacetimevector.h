@@ -34,11 +34,13 @@
 #include <include/parallel_vectors.h>
 
 #include <deal.II/base/utilities.h>
+#include <deal.II/base/thread_management.h>
 #include <deal.II/lac/vector.h>
 #include <deal.II/lac/block_vector_base.h>
 #include <deal.II/lac/block_vector.h>
 
 #include <vector>
+#include <list>
 #include <iostream>
 #include <sstream>
 #include <fstream>
@@ -247,6 +249,37 @@ namespace DOpE
     {
       lock_ = false;
     }
+    /**
+     * Checks whether the spatial vector of the given time point is
+     * currently held in memory. This is always the case except for
+     * the checkpointing behavior.
+     *
+     * @param time_point   The number of the point in the time mesh.
+     */
+    bool IsStored(unsigned int time_point) const;
+    /**
+     * Frees the memory of the spatial vector at the given time point.
+     * Only available in the checkpointing behavior, the next writing
+     * access to this time point allocates the vector again.
+     *
+     * @param time_point   The number of the point in the time mesh.
+     */
+    void Release(unsigned int time_point);
+    /**
+     * @return             The number of spatial vectors currently held in memory.
+     */
+    unsigned int GetNStored() const;
+    /**
+     * Prints the achieved compression ratio and the time spent for
+     * compression and decompression if the behavior is compressed, and
+     * the cache hits and misses if store_on_disc is used with a
+     * memory_budget.
+     *
+     * @param out    The output stream.
+     *
+     * @return       False if there is nothing to report.
+     */
+    bool PrintStorageInfos(std::stringstream &out) const;
     /**
      * This returns the behavior of the SpaceTimeVector
      * Currently implemented are the following possibilities
@@ -255,7 +288,35 @@ namespace DOpE
      *
      * @par  store_on_disc    Means there are only three spatial vectors (for the actual timepoint
      *                        and his two neighbors) stored in the main memory whereas the rest of
-     *                        the spacetimevector is stored on the hard disc.
+     *                        the spacetimevector is stored on the hard disc. If the parameter
+     *                        memory_budget is set, the most recently used time points are kept
+     *                        in main memory and only the others are written to the disc. The
+     *                        budget of memory_budget MB is shared by all SpaceTimeVectors of the
+     *                        same vector type, e.g., the state, adjoint and control vectors of a
+     *                        problem, and the least recently used time point of any of them is
+     *                        written to the disc first.
+     *
+     * @par  mapped_file      Like store_on_disc, but all time points are stored in one memory
+     *                        mapped file with a fixed offset per time point. The operating
+     *                        system decides which parts of the file are kept in main memory.
+     *                        Only available for serial vectors, i.e., dealii::Vector and
+     *                        dealii::BlockVector.
+     *
+     * @par  compressed       Like store_on_disc, but the time points that are not in use are
+     *                        kept compressed in main memory with zlib. If compression_tolerance
+     *                        is zero the compression is lossless, otherwise the entries are
+     *                        quantized such that the error in each entry is bounded by
+     *                        compression_tolerance times the maximum norm of the time step.
+     *                        A lossy compressed state perturbs the adjoint and tangent problems
+     *                        and thus the reduced gradient by about the same relative amount,
+     *                        so compression_tolerance should be well below the relative
+     *                        tolerance of the optimization algorithm, e.g., nonlinear_tol
+     *                        of the ReducedNewtonAlgorithm. Needs deal.II 9.0 or newer.
+     *
+     * @par  checkpointing    Means only the spatial vectors that have been written and not yet
+     *                        released are kept in main memory. Reading a time point that is not
+     *                        stored throws an exception, so the owner of the vector needs to
+     *                        recompute it from a checkpoint.
      *
      * @return               A string indicating the behavior.
      */
@@ -322,12 +383,49 @@ namespace DOpE
     void
     ReSizeSpace (const unsigned int time_point) const;
 
+    /**
+     * A spatial vector that is written to or read from the disc in the
+     * background. As long as the slice exists, vector_ holds the values
+     * of time_point_, so it also serves as cache for the next access.
+     */
+    struct AsyncSlice
+    {
+      unsigned int time_point_;
+      VECTOR *vector_;
+      dealii::Threads::Task<void> task_;
+    };
     /**
      * Sets the membervariable '_filename' to the name of the file (e.g. the whole path!) corresponding to 'time_point'.
      *
      * @ param time_point     The timepoint we are actually interested in.
      */
     void MakeName(unsigned int time_point) const;
+    /**
+     * True for the behaviors that keep only the spatial vectors of the
+     * current interval in local_vectors_ and the rest serialized, i.e.,
+     * on the disc or compressed in main memory.
+     */
+    bool IsSerialized() const
+    {
+      return (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc
+              || GetBehavior() == DOpEtypes::VectorStorageType::mapped_file
+              || GetBehavior() == DOpEtypes::VectorStorageType::compressed);
+    }
+    /**
+     * Creates the file for the mapped_file behavior with a slot for
+     * each time point of the size given by the SpaceTimeHandler and maps
+     * it into memory. An old mapping is removed.
+     */
+    void MapFile() const;
+    /**
+     * Removes the mapping of the mapped_file behavior and closes the file.
+     */
+    void UnmapFile() const;
+    /**
+     * Returns the name of the file corresponding to 'time_point' without
+     * touching filename_, so it can be used by the background tasks.
+     */
+    std::string FileName(unsigned int time_point) const;
     /**
      * Stores the BlockVector stored in stvector_[1] on the Disc. The name of the file will be
      * createt by the function call 'MakeName(local_stvector_.at(1))'.
@@ -370,6 +468,70 @@ namespace DOpE
      */
     void ResizeLocalVectors(unsigned int size) const;
 
+    /**
+     * Copies vector into a buffer and writes it to the disc in the background.
+     */
+    void AsyncStore(unsigned int time_point, const VECTOR &vector) const;
+    /**
+     * Starts reading time_point from the disc in the background, if
+     * it is on the disc and not already in a buffer.
+     */
+    void AsyncPrefetch(unsigned int time_point) const;
+    /**
+     * Guesses the direction of the traversal from the last accessed
+     * time points and prefetches the next time point in this direction.
+     *
+     * @param first, last   The smallest and largest time point that have
+     *                      just been loaded.
+     */
+    void AsyncReadAhead(unsigned int first, unsigned int last) const;
+    /**
+     * Copies time_point from a buffer into vector, if it is available.
+     *
+     * @return              Whether time_point has been found in the buffers.
+     */
+    bool AsyncFetch(unsigned int time_point, VECTOR &vector) const;
+    /**
+     * Finishes all background tasks of time_point and frees their buffers.
+     */
+    void AsyncDrop(unsigned int time_point) const;
+    /**
+     * Finishes all background tasks and frees their buffers.
+     */
+    void AsyncWaitAll() const;
+    /**
+     * Returns a buffer for a new background task. If all n_async_buffers_
+     * buffers are in use, the oldest task is finished and its buffer reused.
+     */
+    VECTOR *AsyncBuffer() const;
+
+    /**
+     * Writes the given spatial vector of the time point into its file.
+     */
+    void WriteToDisc(unsigned int time_point, const VECTOR &vector) const;
+    /**
+     * Helper functions for the memory_budget of store_on_disc.
+     * CacheStore puts a copy of the vector in front of the cache, which is
+     * shared by all vectors, and writes the least recently used time points,
+     * of any vector, to the disc until the cache fits into the budget again.
+     * CacheEvict writes one cached time point of this vector to the disc.
+     * CacheFetch copies a cached time point into vector and returns false
+     * if it is not cached.
+     * CacheFlush writes all cached time points to the disc, CacheClear
+     * drops them without writing.
+     */
+    void CacheStore(unsigned int time_point, const VECTOR &vector) const;
+    void CacheEvict(unsigned int time_point) const;
+    bool CacheFetch(unsigned int time_point, VECTOR &vector) const;
+    void CacheFlush() const;
+    void CacheClear() const;
+
+    /**
+     * Helper function for the checkpointing behavior, returns the spatial
+     * vector at time_point and throws if it is currently not stored.
+     */
+    VECTOR &GetCheckpoint(int time_point, const std::string &caller) const;
+
     mutable std::vector<VECTOR *> stvector_;
     mutable std::vector<SpatialVectorInfos> stvector_information_;
 
@@ -386,6 +548,37 @@ namespace DOpE
     //Needed in the only_recent case to decide if the operation is allowed.
     mutable unsigned int current_dof_number_;
 
+    //Needed in the mapped_file case, offsets in bytes of the time points in
+    //the mapping, the last entry is the size of the mapping.
+    mutable char *mapping_;
+    mutable int mapping_fd_;
+    mutable std::vector<size_t> mapping_offsets_;
+
+    //Needed in the compressed case, the compressed time points and the
+    //statistics for PrintStorageInfos.
+    mutable std::vector<std::vector<char> > compressed_;
+    double compression_tolerance_;
+    mutable double compression_time_;
+    mutable double decompression_time_;
+
+    //Needed in the store_on_disc case with a memory_budget, the cached
+    //time points of this vector and their positions in cache_list_.
+    mutable std::map<unsigned int, std::pair<VECTOR *, typename std::list<std::pair<const SpaceTimeVector<VECTOR> *, unsigned int> >::iterator> > cache_index_;
+    mutable size_t cache_bytes_;
+    size_t memory_budget_;
+    //The cached time points of all vectors with the most recently used one
+    //in front, and the sum of their sizes, which is compared with memory_budget_
+    static std::list<std::pair<const SpaceTimeVector<VECTOR> *, unsigned int> > cache_list_;
+    static size_t total_cache_bytes_;
+    mutable unsigned int cache_hits_;
+    mutable unsigned int cache_misses_;
+
+    //Needed in the store_on_disc case for background read/write operations
+    mutable std::list<AsyncSlice> async_slices_;
+    mutable std::vector<VECTOR *> async_free_;
+    mutable int last_time_point_;
+    unsigned int n_async_buffers_;
+
     //pointer to the dofs in the actual interval. Is only used if the interval is set!
     mutable std::vector<VECTOR *> local_vectors_;
 
@@ -418,7 +611,8 @@ namespace DOpE
       GetSpaceTimeHandler ()->GetDoFsPerBlock (vector_type_, time_point);
 
     if (GetBehavior () == DOpEtypes::VectorStorageType::fullmem || GetBehavior ()
-        == DOpEtypes::VectorStorageType::only_recent)
+        == DOpEtypes::VectorStorageType::only_recent || GetBehavior ()
+        == DOpEtypes::VectorStorageType::checkpointing)
       {
         if (accessor_ >= 0)
           {
@@ -472,7 +666,7 @@ namespace DOpE
       }
     else
       {
-        if (GetBehavior () == DOpEtypes::VectorStorageType::store_on_disc)
+        if (IsSerialized ())
           {
             if (accessor_ >= 0)
               {
@@ -530,7 +724,8 @@ namespace DOpE
       return;
 
     if (GetBehavior () == DOpEtypes::VectorStorageType::fullmem || GetBehavior ()
-        == DOpEtypes::VectorStorageType::only_recent)
+        == DOpEtypes::VectorStorageType::only_recent || GetBehavior ()
+        == DOpEtypes::VectorStorageType::checkpointing)
       {
         if (accessor_ >= 0)
           {
@@ -571,7 +766,7 @@ namespace DOpE
       }
     else
       {
-        if (GetBehavior () == DOpEtypes::VectorStorageType::store_on_disc)
+        if (IsSerialized ())
           {
             if (accessor_ >= 0)
               {
@@ -119,6 +119,33 @@ namespace DOpE
 
     /******************************************************/
 
+    /**
+     * Implements the non-stiff terms of ElementEquation, e.g., convection
+     * or reaction terms, which are treated explicitly in time by the
+     * IMEX Runge-Kutta schemes. These terms must also be contained in
+     * ElementEquation, all other time stepping schemes ignore this function.
+     *
+     * @param edc                The ElementDataContainer object which provides
+     *                           access to all information on the element,
+     *                           e.g., test-functions, mesh size,...
+     * @param local_vector  The vector containing the integrals
+     *                           ordered according to the local number
+     *                           of the testfunction.
+     * @param scale              A scaling parameter to be used in all
+     *                           equations.
+     */
+    virtual void
+    ElementEquationExplicit(
+      const EDC<DH, VECTOR, dealdim> & /*edc*/,
+      dealii::Vector<double> &/*local_vector*/,
+      double /*scale*/)
+    {
+      //This should be left empty, then the IMEX schemes treat
+      //the complete ElementEquation implicitly.
+    }
+
+    /******************************************************/
+
     /**
      * This function is used for error estimation and should implement
     * the strong form of the residual on an element T.
@@ -818,6 +845,30 @@ namespace DOpE
       throw DOpEException("Not Implemented", "PDEInterface::ElementMatrix");
     }
 
+    /******************************************************/
+    /**
+     * This implements the element integral used to calculate the
+     * matrix corresponding to ElementEquationExplicit. The IMEX
+     * Runge-Kutta schemes subtract it from ElementMatrix.
+     *
+     * @param edc                The ElementDataContainer object which provides
+     *                           access to all information on the element,
+     *                           e.g., test-functions, mesh size,...
+     * @param local_entry_matrix The matrix containing the integrals
+     *                           ordered according to the local number
+     *                           of the testfunction.
+     * @param scale              A scaling parameter to be used in all
+     *                           equations.
+     */
+    virtual void
+    ElementMatrixExplicit(
+      const EDC<DH, VECTOR, dealdim> & /*edc*/,
+      dealii::FullMatrix<double> &/*local_entry_matrix*/,
+      double /*scale*/)
+    {
+      //This should be left empty if ElementEquationExplicit is empty.
+    }
+
     /******************************************************/
     /**
      * This implements the element integral used to calculate the
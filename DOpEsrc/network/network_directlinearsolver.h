@@ -85,10 +85,11 @@ namespace DOpE
        *                              should be build by the linear solver in the first iteration.
        *            The default is false, meaning that if we have no idea we don't
        *            want to build a matrix.
+       * @param relative_tol          Ignored, the system is solved exactly.
        *
        */
       template<typename PROBLEM, typename INTEGRATOR>
-      void Solve(PROBLEM &pde, INTEGRATOR &integr, BlockVector<double> &rhs, BlockVector<double> &solution, bool force_matrix_build=false);
+      void Solve(PROBLEM &pde, INTEGRATOR &integr, BlockVector<double> &rhs, BlockVector<double> &solution, bool force_matrix_build=false, double relative_tol=0.);
 
     protected:
 
@@ -163,7 +164,8 @@ namespace DOpE
                                              INTEGRATOR &integr,
                                              BlockVector<double> &rhs,
                                              BlockVector<double> &solution,
-                                             bool force_matrix_build)
+                                             bool force_matrix_build,
+                                             double /*relative_tol*/)
     {
       if (force_matrix_build)
         {
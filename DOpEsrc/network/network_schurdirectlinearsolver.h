@@ -0,0 +1,387 @@
+/**
+*
+* Copyright (C) 2012-2018 by the DOpElib authors
+*
+* This file is part of DOpElib
+*
+* DOpElib is free software: you can redistribute it
+* and/or modify it under the terms of the GNU General Public
+* License as published by the Free Software Foundation, either
+* version 3 of the License, or (at your option) any later
+* version.
+*
+* DOpElib is distributed in the hope that it will be
+* useful, but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* Please refer to the file LICENSE.TXT included in this distribution
+* for further information on this license.
+*
+**/
+
+#ifndef NETWORK_SCHUR_DIRECT_LINEAR_SOLVER_H_
+#define NETWORK_SCHUR_DIRECT_LINEAR_SOLVER_H_
+
+#include <deal.II/lac/vector.h>
+#include <deal.II/lac/block_vector.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/block_sparsity_pattern.h>
+#include <deal.II/lac/block_sparse_matrix.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparse_direct.h>
+#include <deal.II/base/thread_management.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <include/parameterreader.h>
+
+namespace DOpE
+{
+  namespace Networks
+  {
+    /**
+     * @class SchurDirectLinearSolverWithMatrix
+     *
+     * This class provides a linear solve for the nonlinear solvers of DOpE, and can be
+     * used in place of Networks::DirectLinearSolverWithMatrix.
+     *
+     * The matrix of a network has the block structure
+     *
+     *   | A_0           B_0 |
+     *   |     ...       ... |
+     *   |         A_n-1 B_n-1 |
+     *   | C_0 ... C_n-1 D   |
+     *
+     * with one block A_p for each pipe p and the coupling of the
+     * boundary fluxes given by the last block row and column.
+     * Instead of factorizing the whole matrix, each A_p is factorized independently
+     * (concurrently by the deal.II task scheduler), and the small Schur complement
+     *
+     *   S = D - sum_p C_p A_p^{-1} B_p
+     *
+     * for the fluxes is assembled and factorized. Since each B_p only couples to
+     * the fluxes of pipe p, only a few solves with A_p are needed and S is sparse.
+     * Hence the costs are linear in the number of pipes.
+     *
+     * If a pipe block can not be factorized on its own, e.g., if it is singular
+     * without the fluxes, the solver falls back to the factorization of the whole matrix.
+     */
+    class SchurDirectLinearSolverWithMatrix
+    {
+    public:
+      SchurDirectLinearSolverWithMatrix(ParameterReader &param_reader);
+      ~SchurDirectLinearSolverWithMatrix();
+
+      static void declare_params(ParameterReader &param_reader);
+
+      /**
+         This Function should be called once after grid refinement, or changes in boundary values
+         to  recompute sparsity patterns, and constraint matrices.
+       */
+      template<typename PROBLEM>
+      void ReInit(PROBLEM &pde);
+
+      /**
+       * Solves the linear PDE in the form Ax = b using the Schur complement
+       * of the fluxes.
+       *
+       *
+       * @tparam <PROBLEM>            The problem that we want to solve, this is passed on to the INTEGRATOR
+       *                              to calculate the matrix.
+       * @tparam <INTEGRATOR>         The integrator used to calculate the matrix A.
+       * @param rhs                   Right Hand Side of the Equation, i.e., the VECTOR b.
+       *                              Note that rhs is not const, this is because we need to apply
+       *                              the boundary values to this vector!
+       * @param solution              The Approximate Solution of the Linear Equation.
+       *                              It is assumed to be zero! Upon completion this VECTOR stores x
+       * @param force_build_matrix    A boolean value, that indicates whether the Matrix
+       *                              should be build by the linear solver in the first iteration.
+       *            The default is false, meaning that if we have no idea we don't
+       *            want to build a matrix.
+       * @param relative_tol          Ignored, the system is solved exactly.
+       *
+       */
+      template<typename PROBLEM, typename INTEGRATOR>
+      void Solve(PROBLEM &pde, INTEGRATOR &integr, BlockVector<double> &rhs, BlockVector<double> &solution, bool force_matrix_build=false, double relative_tol=0.);
+
+    protected:
+
+    private:
+      /**
+       * Factorizes the pipe blocks and the Schur complement.
+       * Returns false if a pipe block could not be factorized.
+       */
+      bool Factorize();
+
+      /**
+       * Factorizes A_p and computes A_p^{-1}B_p for the nonzero columns of B_p.
+       */
+      void FactorizePipe(unsigned int p);
+
+      dealii::BlockSparsityPattern sparsity_pattern_;
+      dealii::BlockSparseMatrix<double> matrix_;
+
+#if DEAL_II_VERSION_GTE(9,3,0)
+      MethodOfLines_Network_SpaceTimeHandler<FESystem,false,BlockVector<double>,0,1> *sth_ = nullptr;
+#else
+      MethodOfLines_Network_SpaceTimeHandler<FESystem,DoFHandler,BlockVector<double>,0,1> *sth_ = nullptr;
+#endif
+      unsigned int n_pipes_ = 0;
+      bool factorized_ = false;
+      bool use_schur_ = true;
+
+      std::vector<std::unique_ptr<dealii::SparseDirectUMFPACK> > pipe_solvers_;
+      std::vector<bool> pipe_solver_failed_;
+      /// The nonzero columns of B_p
+      std::vector<std::vector<unsigned int> > coupling_columns_;
+      /// The nonzero rows of C_p
+      std::vector<std::vector<unsigned int> > coupling_rows_;
+      /// A_p^{-1}B_p for the nonzero columns of B_p
+      std::vector<std::vector<dealii::Vector<double> > > coupling_solutions_;
+
+      dealii::SparsityPattern schur_sparsity_;
+      dealii::SparseMatrix<double> schur_;
+      dealii::SparseDirectUMFPACK schur_direct_;
+      //Fallback
+      dealii::SparseDirectUMFPACK A_direct_;
+    };
+
+    /*********************************Implementation************************************************/
+
+    void SchurDirectLinearSolverWithMatrix::declare_params(ParameterReader &/*param_reader*/)
+    {
+    }
+
+    /******************************************************/
+
+    SchurDirectLinearSolverWithMatrix::SchurDirectLinearSolverWithMatrix(
+      ParameterReader &/*param_reader*/)
+    {
+    }
+
+    /******************************************************/
+
+    SchurDirectLinearSolverWithMatrix::~SchurDirectLinearSolverWithMatrix()
+    {
+    }
+
+    /******************************************************/
+
+    template<typename PROBLEM>
+    void  SchurDirectLinearSolverWithMatrix::ReInit(PROBLEM &pde)
+    {
+#if DEAL_II_VERSION_GTE(9,3,0)
+      sth_ = dynamic_cast<MethodOfLines_Network_SpaceTimeHandler<FESystem,false,BlockVector<double>,0,1>*>(pde.GetBaseProblem().GetSpaceTimeHandler());
+#else
+      sth_ = dynamic_cast<MethodOfLines_Network_SpaceTimeHandler<FESystem,DoFHandler,BlockVector<double>,0,1>*>(pde.GetBaseProblem().GetSpaceTimeHandler());
+#endif
+      if (sth_ == NULL)
+        {
+          throw DOpEException("Using Networks::SchurDirectLinearSolverWithMatrix with wrong SpaceTimeHandler","SchurDirectLinearSolverWithMatrix::ReInit");
+        }
+      n_pipes_ =  sth_->GetNPipes();
+
+      matrix_.clear();
+      pde.ComputeSparsityPattern(sparsity_pattern_);
+      matrix_.reinit(sparsity_pattern_);
+
+      factorized_ = false;
+      use_schur_ = true;
+      pipe_solvers_.clear();
+      pipe_solvers_.resize(n_pipes_);
+      pipe_solver_failed_.assign(n_pipes_,false);
+      coupling_columns_.assign(n_pipes_,std::vector<unsigned int>());
+      coupling_rows_.assign(n_pipes_,std::vector<unsigned int>());
+      coupling_solutions_.assign(n_pipes_,std::vector<dealii::Vector<double> >());
+    }
+
+    /******************************************************/
+
+    void SchurDirectLinearSolverWithMatrix::FactorizePipe(unsigned int p)
+    {
+      const dealii::SparseMatrix<double> &A = matrix_.block(p,p);
+      const dealii::SparseMatrix<double> &B = matrix_.block(p,n_pipes_);
+      const dealii::SparseMatrix<double> &C = matrix_.block(n_pipes_,p);
+
+      try
+        {
+          pipe_solvers_[p].reset(new dealii::SparseDirectUMFPACK);
+          pipe_solvers_[p]->initialize(A);
+        }
+      catch (dealii::ExceptionBase &)
+        {
+          pipe_solver_failed_[p] = true;
+          return;
+        }
+
+      //Columns of B_p and rows of C_p with entries
+      std::vector<unsigned int> &cols = coupling_columns_[p];
+      cols.clear();
+      for (unsigned int i = 0; i < B.m(); i++)
+        for (auto it = B.begin(i); it != B.end(i); ++it)
+          if (it->value() != 0.)
+            cols.push_back(it->column());
+      std::sort(cols.begin(), cols.end());
+      cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+
+      std::vector<unsigned int> &rows = coupling_rows_[p];
+      rows.clear();
+      for (unsigned int i = 0; i < C.m(); i++)
+        for (auto it = C.begin(i); it != C.end(i); ++it)
+          if (it->value() != 0.)
+            {
+              rows.push_back(i);
+              break;
+            }
+
+      //A_p^{-1}B_p
+      std::vector<dealii::Vector<double> > &X = coupling_solutions_[p];
+      X.assign(cols.size(), dealii::Vector<double>(A.m()));
+      for (unsigned int i = 0; i < B.m(); i++)
+        for (auto it = B.begin(i); it != B.end(i); ++it)
+          {
+            auto pos = std::lower_bound(cols.begin(), cols.end(), it->column());
+            if (pos != cols.end() && *pos == it->column())
+              X[pos-cols.begin()](i) = it->value();
+          }
+      for (unsigned int j = 0; j < X.size(); j++)
+        pipe_solvers_[p]->solve(X[j]);
+    }
+
+    /******************************************************/
+
+    bool SchurDirectLinearSolverWithMatrix::Factorize()
+    {
+      dealii::Threads::TaskGroup<void> tasks;
+      for (unsigned int p = 0; p < n_pipes_; p++)
+        tasks += dealii::Threads::new_task([this, p]()
+        {
+          this->FactorizePipe(p);
+        });
+      tasks.join_all();
+
+      for (unsigned int p = 0; p < n_pipes_; p++)
+        if (pipe_solver_failed_[p])
+          return false;
+
+      //Assemble the Schur complement S = D - sum_p C_p A_p^{-1} B_p
+      const dealii::SparseMatrix<double> &D = matrix_.block(n_pipes_,n_pipes_);
+      const unsigned int n_flux = D.m();
+      dealii::DynamicSparsityPattern dsp(n_flux, n_flux);
+      for (unsigned int i = 0; i < n_flux; i++)
+        for (auto it = D.begin(i); it != D.end(i); ++it)
+          dsp.add(i, it->column());
+      for (unsigned int p = 0; p < n_pipes_; p++)
+        for (unsigned int r = 0; r < coupling_rows_[p].size(); r++)
+          for (unsigned int c = 0; c < coupling_columns_[p].size(); c++)
+            dsp.add(coupling_rows_[p][r], coupling_columns_[p][c]);
+
+      schur_.clear();
+      schur_sparsity_.copy_from(dsp);
+      schur_.reinit(schur_sparsity_);
+      for (unsigned int i = 0; i < n_flux; i++)
+        for (auto it = D.begin(i); it != D.end(i); ++it)
+          schur_.add(i, it->column(), it->value());
+
+      for (unsigned int p = 0; p < n_pipes_; p++)
+        {
+          const dealii::SparseMatrix<double> &C = matrix_.block(n_pipes_,p);
+          for (unsigned int r = 0; r < coupling_rows_[p].size(); r++)
+            {
+              const unsigned int row = coupling_rows_[p][r];
+              for (unsigned int c = 0; c < coupling_columns_[p].size(); c++)
+                {
+                  double value = 0.;
+                  for (auto it = C.begin(row); it != C.end(row); ++it)
+                    value += it->value() * coupling_solutions_[p][c](it->column());
+                  schur_.add(row, coupling_columns_[p][c], -value);
+                }
+            }
+        }
+      schur_direct_.initialize(schur_);
+      return true;
+    }
+
+    /******************************************************/
+
+    template<typename PROBLEM, typename INTEGRATOR>
+    void SchurDirectLinearSolverWithMatrix::Solve(PROBLEM &pde,
+                                                  INTEGRATOR &integr,
+                                                  BlockVector<double> &rhs,
+                                                  BlockVector<double> &solution,
+                                                  bool force_matrix_build,
+                                                  double /*relative_tol*/)
+    {
+      if (force_matrix_build)
+        {
+          integr.ComputeMatrix (pde,matrix_);
+        }
+
+      if (!factorized_ || force_matrix_build)
+        {
+          std::fill(pipe_solver_failed_.begin(), pipe_solver_failed_.end(), false);
+          use_schur_ = Factorize();
+          if (!use_schur_)
+            {
+              A_direct_.initialize(matrix_);
+            }
+          factorized_ = true;
+        }
+
+      if (use_schur_)
+        {
+          //y_p = A_p^{-1} f_p
+          dealii::Threads::TaskGroup<void> tasks;
+          for (unsigned int p = 0; p < n_pipes_; p++)
+            tasks += dealii::Threads::new_task([this, &rhs, &solution, p]()
+            {
+              solution.block(p) = rhs.block(p);
+              this->pipe_solvers_[p]->solve(solution.block(p));
+            });
+          tasks.join_all();
+
+          //S lambda = g - sum_p C_p y_p
+          dealii::Vector<double> lambda(rhs.block(n_pipes_));
+          for (unsigned int p = 0; p < n_pipes_; p++)
+            {
+              const dealii::SparseMatrix<double> &C = matrix_.block(n_pipes_,p);
+              for (unsigned int r = 0; r < coupling_rows_[p].size(); r++)
+                {
+                  const unsigned int row = coupling_rows_[p][r];
+                  for (auto it = C.begin(row); it != C.end(row); ++it)
+                    lambda(row) -= it->value() * solution.block(p)(it->column());
+                }
+            }
+          schur_direct_.solve(lambda);
+          solution.block(n_pipes_) = lambda;
+
+          //x_p = y_p - A_p^{-1} B_p lambda
+          for (unsigned int p = 0; p < n_pipes_; p++)
+            for (unsigned int c = 0; c < coupling_columns_[p].size(); c++)
+              solution.block(p).add(-lambda(coupling_columns_[p][c]), coupling_solutions_[p][c]);
+        }
+      else
+        {
+          dealii::Vector<double> sol;
+          sol = rhs;
+          A_direct_.solve(sol);
+          solution = sol;
+        }
+
+      for (unsigned int p = 0; p < n_pipes_; p++)
+        {
+          sth_->SelectPipe(p);
+          pde.GetDoFConstraints().distribute(solution.block(p));
+        }
+      sth_->SelectPipe(n_pipes_);
+
+    }
+
+///////////////Endof Namespaces
+  }
+}
+#endif
@@ -35,6 +35,7 @@
 
 #include <include/helper.h>
 #include <include/parameterreader.h>
+#include <templates/newtonforcingterm.h>
 
 namespace DOpE
 {
@@ -103,6 +104,7 @@ namespace DOpE
 
     private:
       INTEGRATOR &integrator_;
+      NewtonForcingTerm forcing_;
 
       bool build_matrix_;
 
@@ -126,6 +128,7 @@ namespace DOpE
       param_reader.declare_entry("line_maxiter", "4",Patterns::Integer(0),"maximal number of linesearch steps");
       param_reader.declare_entry("linesearch_rho", "0.9",Patterns::Double(0),"reduction rate for the linesearch damping paramete");
 
+      NewtonForcingTerm::declare_params(param_reader);
       LINEARSOLVER::declare_params(param_reader);
     }
 
@@ -134,7 +137,7 @@ namespace DOpE
     template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
     NewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
     ::NewtonSolver(INTEGRATOR &integrator, ParameterReader &param_reader)
-      : LINEARSOLVER(param_reader), integrator_(integrator)
+      : LINEARSOLVER(param_reader), integrator_(integrator), forcing_(param_reader)
     {
       param_reader.SetSubsection("newtonsolver parameters");
       nonlinear_global_tol_ = param_reader.get_double ("nonlinear_global_tol");
@@ -210,6 +213,7 @@ namespace DOpE
       double res = residual.linfty_norm();
       double firstres = res;
       double lastres = res;
+      forcing_.Reset(std::max(nonlinear_global_tol_, firstres * nonlinear_tol_));
 
       out<< algo_level << "Newton step: " <<0<<"\t Residual (abs.): "
          << pde.GetOutputHandler ()->ZeroTolerance (res, 1.0) << "\n";
@@ -235,7 +239,7 @@ namespace DOpE
           pde.GetOutputHandler()->SetIterationNumber(iter,"PDENewton");
 
           LINEARSOLVER::Solve (pde, GetIntegrator (), residual, du,
-                               build_matrix);
+                               build_matrix, forcing_.GetLinearTolerance ());
 
           //Linesearch
           {
@@ -321,6 +325,7 @@ namespace DOpE
                 if (res/lastres > nonlinear_rho_)
                   build_matrix=true;
 
+                forcing_.Update(newres,res);
                 lastres=res;
                 res=newres;
 
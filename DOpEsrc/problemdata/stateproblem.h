@@ -221,6 +221,16 @@ namespace DOpE
                     dealii::Vector<double> &local_vector, double scale,
                     double scale_ico);
 
+    /**
+     * Computes the non-stiff part of the element equation which is
+     * treated explicitly by IMEX time stepping schemes.
+     * These terms are also contained in ElementEquation.
+     */
+    template<typename EDC>
+    inline void
+    ElementEquationExplicit(const EDC &edc,
+                            dealii::Vector<double> &local_vector, double scale = 1.);
+
     /**
      * This function has the same functionality as the ElementEquation function.
      * It is needed for time derivatives when working with
@@ -306,6 +316,14 @@ namespace DOpE
                   dealii::FullMatrix<double> &local_entry_matrix, double scale = 1.,
                   double scale_ico = 1.);
 
+    /**
+     * Computes the directional derivatives of ElementEquationExplicit.
+     */
+    template<typename EDC>
+    inline void
+    ElementMatrixExplicit(const EDC &edc,
+                          dealii::FullMatrix<double> &local_entry_matrix, double scale = 1.);
+
     /**
      * Computes the value of the element matrix which is derived
      * by computing the directional derivatives of the time residuum of the PDE
@@ -668,6 +686,19 @@ namespace DOpE
 
   /******************************************************/
 
+  template<typename OPTPROBLEM, typename PDE, typename DD,
+           typename SPARSITYPATTERN, typename VECTOR, int dim>
+  template<typename EDC>
+  void
+  StateProblem<OPTPROBLEM, PDE, DD, SPARSITYPATTERN, VECTOR,
+               dim>::ElementEquationExplicit(const EDC &edc,
+                                             dealii::Vector<double> &local_vector, double scale)
+  {
+    pde_.ElementEquationExplicit(edc, local_vector, scale*interval_length_);
+  }
+
+  /******************************************************/
+
   template<typename OPTPROBLEM, typename PDE, typename DD,
            typename SPARSITYPATTERN, typename VECTOR, int dim>
   template<typename EDC>
@@ -798,6 +829,19 @@ namespace DOpE
 
   /******************************************************/
 
+  template<typename OPTPROBLEM, typename PDE, typename DD,
+           typename SPARSITYPATTERN, typename VECTOR, int dim>
+  template<typename EDC>
+  void
+  StateProblem<OPTPROBLEM, PDE, DD, SPARSITYPATTERN, VECTOR,
+               dim>::ElementMatrixExplicit(const EDC &edc,
+                                           dealii::FullMatrix<double> &local_entry_matrix, double scale)
+  {
+    pde_.ElementMatrixExplicit(edc, local_entry_matrix, scale*interval_length_);
+  }
+
+  /******************************************************/
+
   template<typename OPTPROBLEM, typename PDE, typename DD,
            typename SPARSITYPATTERN, typename VECTOR, int dim>
   template<typename EDC>
@@ -64,6 +64,9 @@
 
 #include <fstream>
 #include <string>
+#include <algorithm>
+#include <limits>
+#include <cmath>
 
 namespace DOpE
 {
@@ -182,6 +185,7 @@ namespace DOpE
     void StateSizeInfo(std::stringstream &out) override
     {
       GetU().PrintInfos(out);
+      this->GetProblem()->GetSpaceTimeHandler()->PrintDoFNumberingInfos(out);
     }
 
     /******************************************************/
@@ -282,6 +286,33 @@ namespace DOpE
     void BackwardTimeLoop(PDE &problem, StateVector<VECTOR> &sol, std::string outname, bool eval_grads);
 
   private:
+    /**
+     * Helper function for AdaptiveTimeStep. Does one
+     * step of the time stepping scheme from t_from to t_to. The time DoF from
+     * in the interval first and the time DoF to in the interval last select
+     * the mesh and the auxiliary vectors, the step size given to the PDE is
+     * t_to-t_from, which may differ from the length of the intervals.
+     *
+     * @return   The value of build_matrix for the next step with the same step size.
+     */
+    template<typename PDE>
+    bool TimeStep(PDE &problem,
+                  const TimeIterator &first, unsigned int from, double t_from,
+                  const TimeIterator &last, unsigned int to, double t_to,
+                  const VECTOR &u_old, VECTOR &u_new, bool build_matrix);
+    /**
+     * Replaces the step from the time DoF from to the time DoF to in the
+     * given interval by adaptively chosen substeps. The local error of each
+     * substep is estimated by comparing one step with two steps of half the
+     * size (step doubling). Substeps with a relative error above
+     * time_step_tol_ are rejected and repeated with a smaller size, the size
+     * of the last substep is used as first guess in the next interval.
+     */
+    template<typename PDE>
+    void AdaptiveTimeStep(PDE &problem, const TimeIterator &interval,
+                          unsigned int from, unsigned int to,
+                          const VECTOR &u_old, VECTOR &u_new);
+
     /**
      * Helper function to prevent code duplicity. Adds the user defined
      * user Data to the Integrator.
@@ -371,6 +402,14 @@ namespace DOpE
 
     bool project_initial_data_ = false;
 
+    bool adaptive_time_steps_;
+    double time_step_tol_;
+    unsigned int time_step_max_substeps_;
+    unsigned int extrapolation_order_;
+    double substep_;
+    unsigned int n_accepted_substeps_, n_rejected_substeps_;
+    double min_substep_, max_substep_;
+
     friend class SolutionExtractor<InstatPDEProblem<NONLINEARSOLVER,
              INTEGRATOR, PROBLEM, VECTOR, dealdim>,   VECTOR > ;
   };
@@ -394,6 +433,19 @@ namespace DOpE
     param_reader.declare_entry("number of patches", "0",
                                Patterns::Integer(0));
 
+    param_reader.SetSubsection("time step control parameters");
+    param_reader.declare_entry("adaptive_time_steps", "false",
+                               Patterns::Bool(),
+                               "Replace each time step of the state equation by adaptively chosen substeps controlled by a step doubling error estimate.");
+    param_reader.declare_entry("time_step_tol", "1.e-4",
+                               Patterns::Double(0),
+                               "Tolerance for the relative local error of each substep.");
+    param_reader.declare_entry("time_step_max_substeps", "1024",
+                               Patterns::Integer(1),
+                               "The substeps are not made smaller than the time step divided by this number.");
+    param_reader.declare_entry("extrapolation_order", "0",
+                               Patterns::Integer(0,1),
+                               "Order of the polynomial extrapolation from the last two time steps used as initial guess for the Newton method in each time step of the time loops. 0 starts from the last time step solution, 1 uses linear extrapolation. The fractional step theta scheme always starts from the last time step solution.");
   }
   /******************************************************/
 
@@ -421,6 +473,12 @@ namespace DOpE
       state_reinit_ = true;
       adjoint_reinit_ = true;
     }
+    param_reader.SetSubsection("time step control parameters");
+    adaptive_time_steps_ = param_reader.get_bool("adaptive_time_steps");
+    time_step_tol_ = param_reader.get_double("time_step_tol");
+    time_step_max_substeps_ = param_reader.get_integer("time_step_max_substeps");
+    extrapolation_order_ = param_reader.get_integer("extrapolation_order");
+    substep_ = 0.;
   }
 
   /******************************************************/
@@ -474,6 +532,7 @@ namespace DOpE
     build_adjoint_matrix_ = true;
 
     GetU().ReInit();
+    substep_ = 0.;
 
     // Remove all time-params - they are now obsolete
     auxiliary_time_params_.clear();
@@ -501,8 +560,27 @@ namespace DOpE
         state_reinit_ = false;
       }
 
+    if (adaptive_time_steps_ && problem.GetNPreviousTimePoints() > 1)
+      {
+        throw DOpEException("Adaptive time steps are only available for one step schemes, not for "
+                            + problem.GetName() + ".",
+                            "InstatPDEProblem::ComputeReducedState");
+      }
+    n_accepted_substeps_ = 0;
+    n_rejected_substeps_ = 0;
+    min_substep_ = std::numeric_limits<double>::max();
+    max_substep_ = 0.;
     this->ForwardTimeLoop(problem,this->GetU(),"State",true);
 
+    if (adaptive_time_steps_ && n_accepted_substeps_ > 0)
+      {
+        std::stringstream out;
+        this->GetOutputHandler()->InitOut(out);
+        out << "\t Adaptive time steps: " << n_accepted_substeps_ << " accepted, "
+            << n_rejected_substeps_ << " rejected, step sizes from "
+            << min_substep_ << " to " << max_substep_;
+        this->GetOutputHandler()->Write(out, 4 + this->GetBasePriority());
+      }
   }
   /******************************************************/
 
@@ -1020,6 +1098,17 @@ namespace DOpE
        ForwardTimeLoop(PDE &problem, StateVector<VECTOR> &sol, std::string outname, bool eval_funcs)
   {
     VECTOR u_old;
+    //Solution at the time point before u_old, used by multistep schemes
+    VECTOR u_oldold;
+    const bool multistep = (problem.GetNPreviousTimePoints() > 1);
+    bool has_oldold = false;
+    //The extrapolated initial guess for the Newton method needs u_oldold as well
+    const bool keep_oldold = multistep || extrapolation_order_ > 0;
+    double t_oldold = 0.;
+    VECTOR initial_guess;
+    const unsigned int n_iterations =
+      this->GetNonlinearSolver("state").GetNIterations();
+    unsigned int n_time_steps = 0;
 
     unsigned int max_timestep =
       problem.GetSpaceTimeHandler()->GetMaxTimePoint();
@@ -1029,6 +1118,11 @@ namespace DOpE
     n_dofs_per_interval =
       problem.GetSpaceTimeHandler()->GetTimeDoFHandler().GetLocalNbrOfDoFs();
     std::vector<unsigned int> local_to_global(n_dofs_per_interval);
+    if (multistep && n_dofs_per_interval != 2)
+      {
+        throw DOpEException("Multistep schemes need two time DoFs per interval.",
+                            "InstatPDEProblem::ForwardTimeLoop");
+      }
     {
       TimeIterator it =
         problem.GetSpaceTimeHandler()->GetTimeDoFHandler().first_interval();
@@ -1099,6 +1193,9 @@ namespace DOpE
 
             if (transfer_needed)
               {
+                //The solution before u_old lives on the old mesh,
+                //multistep schemes start again with a single step.
+                has_oldold = false;
                 this->GetOutputHandler()->Write(u_old,
                                                 "Transfered_" + outname + this->GetPostIndex(), problem.GetDoFType());
                 this->GetNonlinearSolver("state").ReInit(problem);
@@ -1127,64 +1224,99 @@ namespace DOpE
             sol.SetTimeDoFNumber(local_to_global[i], it);
             sol.GetSpacialVector() = 0;
 
-            if (transfer_needed)
+            if (adaptive_time_steps_ && !transfer_needed)
               {
-                //Auxiliary vectors need to be interpolated!
-                this->GetProblem()->AddAuxiliaryToIntegratorWithTemporalTransfer(
-                  this->GetIntegrator(),local_to_global[i-1], local_to_global[i]);
+                AdaptiveTimeStep(problem, it, local_to_global[i-1], local_to_global[i],
+                                 u_old, sol.GetSpacialVector());
+                //The substeps used different step sizes
+                build_state_matrix_ = true;
+                problem.SetTime(time, local_to_global[i], it);
               }
             else
               {
-                this->GetProblem()->AddAuxiliaryToIntegrator(
-                  this->GetIntegrator());
-              }
+                if (transfer_needed)
+                  {
+                    //Auxiliary vectors need to be interpolated!
+                    this->GetProblem()->AddAuxiliaryToIntegratorWithTemporalTransfer(
+                      this->GetIntegrator(),local_to_global[i-1], local_to_global[i]);
+                  }
+                else
+                  {
+                    this->GetProblem()->AddAuxiliaryToIntegrator(
+                      this->GetIntegrator());
+                  }
 
-            this->GetNonlinearSolver("state").NonlinearLastTimeEvals(problem,
-                                                                     u_old, sol.GetSpacialVector());
-            this->GetOutputHandler()->Write(sol.GetSpacialVector(),
-                                            "LastTimestep_" + outname + this->GetPostIndex(), problem.GetDoFType());
-            if (transfer_needed)
-              {
-                this->GetProblem()->DeleteAuxiliaryFromIntegratorWithTemporalTransfer(
-                  this->GetIntegrator());
-              }
-            else
-              {
-                this->GetProblem()->DeleteAuxiliaryFromIntegrator(
-                  this->GetIntegrator());
-              }
+                problem.SetNAvailableTimePoints((multistep && has_oldold) ? 2 : 1);
+                if (multistep && has_oldold)
+                  this->GetIntegrator().AddDomainData("last_last_time_solution", &u_oldold);
+                this->GetNonlinearSolver("state").NonlinearLastTimeEvals(problem,
+                                                                         u_old, sol.GetSpacialVector());
+                if (multistep && has_oldold)
+                  this->GetIntegrator().DeleteDomainData("last_last_time_solution");
+                this->GetOutputHandler()->Write(sol.GetSpacialVector(),
+                                                "LastTimestep_" + outname + this->GetPostIndex(), problem.GetDoFType());
+                if (transfer_needed)
+                  {
+                    this->GetProblem()->DeleteAuxiliaryFromIntegratorWithTemporalTransfer(
+                      this->GetIntegrator());
+                  }
+                else
+                  {
+                    this->GetProblem()->DeleteAuxiliaryFromIntegrator(
+                      this->GetIntegrator());
+                  }
 
-            problem.SetTime(time, local_to_global[i], it);
+                problem.SetTime(time, local_to_global[i], it);
 
-            this->GetProblem()->AddAuxiliaryToIntegrator(
-              this->GetIntegrator());
-            if (transfer_needed)
-              {
-                this->GetProblem()->AddPreviousAuxiliaryToIntegratorWithTemporalTransfer(
-                  this->GetIntegrator(),local_to_global[i-1], local_to_global[i]);
-              }
-            else
-              {
-                this->GetProblem()->AddPreviousAuxiliaryToIntegrator(
+                this->GetProblem()->AddAuxiliaryToIntegrator(
                   this->GetIntegrator());
-              }
-            //Also rebuild matrix if a mesh transfer happend.
-            build_state_matrix_
-              = this->GetNonlinearSolver("state").NonlinearSolve(problem,
-                                                                 u_old, sol.GetSpacialVector(), true,
-                                                                 build_state_matrix_);
+                if (transfer_needed)
+                  {
+                    this->GetProblem()->AddPreviousAuxiliaryToIntegratorWithTemporalTransfer(
+                      this->GetIntegrator(),local_to_global[i-1], local_to_global[i]);
+                  }
+                else
+                  {
+                    this->GetProblem()->AddPreviousAuxiliaryToIntegrator(
+                      this->GetIntegrator());
+                  }
+                //Start the Newton method from the linear extrapolation
+                //of the last two time steps
+                if (extrapolation_order_ > 0 && has_oldold)
+                  {
+                    const double t_old = times[local_to_global[i-1]];
+                    const double ratio = (time - t_old) / (t_old - t_oldold);
+                    initial_guess = u_old;
+                    initial_guess.sadd(1. + ratio, -ratio, u_oldold);
+                    this->GetIntegrator().AddDomainData("initial_guess", &initial_guess);
+                  }
+                //Also rebuild matrix if a mesh transfer happend.
+                build_state_matrix_
+                  = this->GetNonlinearSolver("state").NonlinearSolve(problem,
+                                                                     u_old, sol.GetSpacialVector(), true,
+                                                                     build_state_matrix_);
+                if (extrapolation_order_ > 0 && has_oldold)
+                  this->GetIntegrator().DeleteDomainData("initial_guess");
 
-            this->GetProblem()->DeleteAuxiliaryFromIntegrator(
-              this->GetIntegrator());
-            if (transfer_needed)
-              {
-                this->GetProblem()->DeletePreviousAuxiliaryFromIntegratorWithTemporalTransfer(
+                this->GetProblem()->DeleteAuxiliaryFromIntegrator(
                   this->GetIntegrator());
+                if (transfer_needed)
+                  {
+                    this->GetProblem()->DeletePreviousAuxiliaryFromIntegratorWithTemporalTransfer(
+                      this->GetIntegrator());
+                  }
+                else
+                  {
+                    this->GetProblem()->DeletePreviousAuxiliaryFromIntegrator(
+                      this->GetIntegrator());
+                  }
               }
-            else
+            n_time_steps++;
+            if (keep_oldold)
               {
-                this->GetProblem()->DeletePreviousAuxiliaryFromIntegrator(
-                  this->GetIntegrator());
+                u_oldold = u_old;
+                t_oldold = times[local_to_global[i-1]];
+                has_oldold = true;
               }
             u_old = sol.GetSpacialVector();
             this->GetOutputHandler()->Write(sol.GetSpacialVector(),
@@ -1199,6 +1331,124 @@ namespace DOpE
               }
           }
       }
+    {
+      //Shows the effect of the initial guess, e.g., of the extrapolation.
+      //The priority is above the usual printlevels of the tests.
+      std::stringstream out;
+      this->GetOutputHandler()->InitOut(out);
+      out << "\t Newton iterations: "
+          << this->GetNonlinearSolver("state").GetNIterations() - n_iterations
+          << " in " << n_time_steps << " time steps";
+      this->GetOutputHandler()->Write(out, 6 + this->GetBasePriority());
+    }
+    problem.SetNAvailableTimePoints(1);
+  }
+
+  /******************************************************/
+
+  template<typename NONLINEARSOLVER,
+           typename INTEGRATOR, typename PROBLEM,
+           typename VECTOR, int dealdim>
+  template<typename PDE>
+  bool InstatPDEProblem<NONLINEARSOLVER,
+       INTEGRATOR, PROBLEM, VECTOR, dealdim>::
+       TimeStep(PDE &problem,
+                const TimeIterator &first, unsigned int from, double t_from,
+                const TimeIterator &last, unsigned int to, double t_to,
+                const VECTOR &u_old, VECTOR &u_new, bool build_matrix)
+  {
+    const double step = t_to - t_from;
+
+    //SetTime takes the step size from the interval, for coarse steps
+    //or substeps it needs to be replaced by the actual step size.
+    problem.SetTime(t_from, from, first);
+    this->GetProblem()->GetPDE().SetTime(t_from, step);
+    u_new.reinit(u_old);
+    this->GetProblem()->AddAuxiliaryToIntegrator(this->GetIntegrator());
+    this->GetNonlinearSolver("state").NonlinearLastTimeEvals(problem,
+                                                             u_old, u_new);
+    this->GetProblem()->DeleteAuxiliaryFromIntegrator(this->GetIntegrator());
+
+    problem.SetTime(t_to, to, last);
+    this->GetProblem()->GetPDE().SetTime(t_to, step);
+    this->GetProblem()->AddAuxiliaryToIntegrator(this->GetIntegrator());
+    this->GetProblem()->AddPreviousAuxiliaryToIntegrator(this->GetIntegrator());
+    build_matrix = this->GetNonlinearSolver("state").NonlinearSolve(problem,
+                   u_old, u_new, true, build_matrix);
+    this->GetProblem()->DeleteAuxiliaryFromIntegrator(this->GetIntegrator());
+    this->GetProblem()->DeletePreviousAuxiliaryFromIntegrator(this->GetIntegrator());
+    return build_matrix;
+  }
+
+  /******************************************************/
+
+  template<typename NONLINEARSOLVER,
+           typename INTEGRATOR, typename PROBLEM,
+           typename VECTOR, int dealdim>
+  template<typename PDE>
+  void InstatPDEProblem<NONLINEARSOLVER,
+       INTEGRATOR, PROBLEM, VECTOR, dealdim>::
+       AdaptiveTimeStep(PDE &problem, const TimeIterator &interval,
+                        unsigned int from, unsigned int to,
+                        const VECTOR &u_old, VECTOR &u_new)
+  {
+    const std::vector<double> &times =
+      problem.GetSpaceTimeHandler()->GetTimes();
+    const double t_end = times[to];
+    const double length = t_end - times[from];
+    const double min_step = length / time_step_max_substeps_;
+    //The error of one step is about 2^p-1 times the error of
+    //the two half steps for a scheme of order p.
+    const unsigned int order = (problem.GetName() == "Crank-Nicolson"
+                                || problem.GetName() == "Fractional-Step-Theta") ? 2 : 1;
+    const double factor = std::pow(2., static_cast<double>(order)) - 1.;
+
+    if (!(substep_ > 0.))
+      substep_ = length;
+    double t = times[from];
+    VECTOR u(u_old);
+    VECTOR full, half;
+    //The matrix depends on the step size, so it is only reused
+    //for steps of the same size.
+    bool build_matrix = true;
+    double matrix_step = 0.;
+    auto step = [&](double t_from, double t_to, const VECTOR & v_old, VECTOR & v_new)
+    {
+      const bool new_step = std::fabs((t_to - t_from) - matrix_step) > 1.e-12 * length;
+      build_matrix = TimeStep(problem, interval, from, t_from, interval, to, t_to,
+                              v_old, v_new, build_matrix || new_step);
+      matrix_step = t_to - t_from;
+    };
+    while (t_end - t > 1.e-12 * length)
+      {
+        const double h = std::min(substep_, t_end - t);
+        const double t_new = (h < t_end - t) ? t + h : t_end;
+        //The two half steps first, so that the matrix can be reused
+        step(t, t + 0.5 * h, u, half);
+        step(t + 0.5 * h, t_new, half, u_new);
+        step(t, t_new, u, full);
+        full -= u_new;
+        const double error = full.l2_norm() / factor
+                             / std::max(u_new.l2_norm(), std::numeric_limits<double>::min());
+        if (error <= time_step_tol_ || h <= min_step * (1. + 1.e-12))
+          {
+            u = u_new;
+            t = t_new;
+            n_accepted_substeps_++;
+            min_substep_ = std::min(min_substep_, h);
+            max_substep_ = std::max(max_substep_, h);
+          }
+        else
+          {
+            n_rejected_substeps_++;
+          }
+        //usual step size controller with safety factor 0.9
+        //and bounded growth and reduction
+        const double scale = (error > 0.) ?
+                             0.9 * std::pow(time_step_tol_ / error, 1. / (order + 1.)) : 2.;
+        substep_ = std::max(min_step, h * std::min(2., std::max(0.2, scale)));
+      }
+    u_new = u;
   }
 
   /******************************************************/
@@ -1212,6 +1462,17 @@ namespace DOpE
        BackwardTimeLoop(PDE &problem, StateVector<VECTOR> &sol, std::string outname, bool eval_grads)
   {
     VECTOR u_old;
+    //Solution at the time point before u_old, used by multistep schemes
+    VECTOR u_oldold;
+    const bool multistep = (problem.GetNPreviousTimePoints() > 1);
+    bool has_oldold = false;
+    //The extrapolated initial guess for the Newton method needs u_oldold as well
+    const bool keep_oldold = multistep || extrapolation_order_ > 0;
+    double t_oldold = 0.;
+    VECTOR initial_guess;
+    const unsigned int n_iterations =
+      this->GetNonlinearSolver("adjoint").GetNIterations();
+    unsigned int n_time_steps = 0;
 
     unsigned int max_timestep =
       problem.GetSpaceTimeHandler()->GetMaxTimePoint();
@@ -1221,6 +1482,11 @@ namespace DOpE
     n_dofs_per_interval =
       problem.GetSpaceTimeHandler()->GetTimeDoFHandler().GetLocalNbrOfDoFs();
     std::vector<unsigned int> local_to_global(n_dofs_per_interval);
+    if (multistep && n_dofs_per_interval != 2)
+      {
+        throw DOpEException("Multistep schemes need two time DoFs per interval.",
+                            "InstatPDEProblem::BackwardTimeLoop");
+      }
     {
       TimeIterator it =
         problem.GetSpaceTimeHandler()->GetTimeDoFHandler().last_interval();
@@ -1282,6 +1548,9 @@ namespace DOpE
 
             if (transfer_needed)
               {
+                //The solution before u_old lives on the old mesh,
+                //multistep schemes start again with a single step.
+                has_oldold = false;
                 this->GetOutputHandler()->Write(u_old,
                                                 "Transfered_" + outname + this->GetPostIndex(), problem.GetDoFType());
                 this->GetNonlinearSolver("adjoint").ReInit(problem);
@@ -1323,8 +1592,13 @@ namespace DOpE
                   this->GetIntegrator());
               }
 
+            problem.SetNAvailableTimePoints((multistep && has_oldold) ? 2 : 1);
+            if (multistep && has_oldold)
+              this->GetIntegrator().AddDomainData("last_last_time_solution", &u_oldold);
             this->GetNonlinearSolver("adjoint").NonlinearLastTimeEvals(problem,
                                                                        u_old, sol.GetSpacialVector());
+            if (multistep && has_oldold)
+              this->GetIntegrator().DeleteDomainData("last_last_time_solution");
 
             if (transfer_needed)
               {
@@ -1347,10 +1621,22 @@ namespace DOpE
               this->GetProblem()->AddPreviousAuxiliaryToIntegrator(
                 this->GetIntegrator());
 
+            //Start the Newton method from the linear extrapolation
+            //of the last two time steps
+            if (extrapolation_order_ > 0 && has_oldold)
+              {
+                const double t_old = times[local_to_global[j+1]];
+                const double ratio = (time - t_old) / (t_old - t_oldold);
+                initial_guess = u_old;
+                initial_guess.sadd(1. + ratio, -ratio, u_oldold);
+                this->GetIntegrator().AddDomainData("initial_guess", &initial_guess);
+              }
             build_adjoint_matrix_
               = this->GetNonlinearSolver("adjoint").NonlinearSolve(problem,
                                                                    u_old, sol.GetSpacialVector(), true,
                                                                    build_adjoint_matrix_);
+            if (extrapolation_order_ > 0 && has_oldold)
+              this->GetIntegrator().DeleteDomainData("initial_guess");
 
             this->GetProblem()->DeleteAuxiliaryFromIntegrator(
               this->GetIntegrator());
@@ -1360,12 +1646,30 @@ namespace DOpE
               this->GetProblem()->DeletePreviousAuxiliaryFromIntegrator(
                 this->GetIntegrator());
 
+            n_time_steps++;
+            if (keep_oldold)
+              {
+                u_oldold = u_old;
+                t_oldold = times[local_to_global[j+1]];
+                has_oldold = true;
+              }
             u_old = sol.GetSpacialVector();
             this->GetOutputHandler()->Write(sol.GetSpacialVector(),
                                             outname + this->GetPostIndex(), problem.GetDoFType());
 
           }//End interval loop
       }//End time loop
+    {
+      //Shows the effect of the initial guess, e.g., of the extrapolation.
+      //The priority is above the usual printlevels of the tests.
+      std::stringstream out;
+      this->GetOutputHandler()->InitOut(out);
+      out << "\t Newton iterations: "
+          << this->GetNonlinearSolver("adjoint").GetNIterations() - n_iterations
+          << " in " << n_time_steps << " time steps";
+      this->GetOutputHandler()->Write(out, 6 + this->GetBasePriority());
+    }
+    problem.SetNAvailableTimePoints(1);
   }
 
   /******************************************************/
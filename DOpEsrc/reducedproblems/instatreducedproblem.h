@@ -242,6 +242,17 @@ namespace DOpE
     void StateSizeInfo(std::stringstream &out) override
     {
       GetU().PrintInfos(out);
+      this->GetProblem()->GetSpaceTimeHandler()->PrintDoFNumberingInfos(out);
+    }
+
+    /**
+     * Returns the total number of time steps of the state equation that
+     * had to be recomputed from a checkpoint. This is only nonzero if the
+     * StateVector uses the checkpointing storage behavior.
+     */
+    unsigned int GetNStateRecomputations() const
+    {
+      return n_state_recomputations_;
     }
 
     /******************************************************/
@@ -358,6 +369,32 @@ namespace DOpE
     template<typename PDE>
     void ForwardTimeLoop(PDE &problem, StateVector<VECTOR> &sol, std::string outname, bool eval_funcs);
 
+    /**
+     * Computes the solution at the end of one time step of a forward
+     * problem. This is used by the ForwardTimeLoop and to recompute
+     * states in the checkpointing behavior, so that both solve
+     * exactly the same problems.
+     *
+     * @param problem        Describes the nonstationary pde to be solved
+     * @param interval       The time interval of the step.
+     * @param dof_old        The time DoF of the known solution u_old.
+     * @param dof_new        The time DoF of the new solution u_new.
+     * @param u_old          The solution at dof_old.
+     * @param u_oldold       The solution at the time point before dof_old
+     *                       or NULL, if not available. It is needed by multistep
+     *                       schemes and for the extrapolated initial guess.
+     * @param t_oldold       The time of u_oldold.
+     * @param u_new          The solution at dof_new.
+     * @param build_matrix   Should the matrix be build.
+     *
+     * @return               The matrix build flag of the nonlinear solver.
+     */
+    template<typename PDE>
+    bool ForwardTimeStep(PDE &problem, const TimeIterator &interval,
+                         unsigned int dof_old, unsigned int dof_new,
+                         const VECTOR &u_old, const VECTOR *u_oldold, double t_oldold,
+                         VECTOR &u_new, bool build_matrix);
+
     /******************************************************/
 
     /**
@@ -429,6 +466,60 @@ namespace DOpE
     std::map<std::string,std::vector<dealii::Vector<double> >>::iterator
                                                             GetAuxiliaryTimeParams(std::string name);
 
+    /**
+     * The checkpointing behavior is only implemented for the state,
+     * all other StateVectors are kept in main memory in this case.
+     */
+    static DOpEtypes::VectorStorageType
+    AuxiliaryBehavior(DOpEtypes::VectorStorageType state_behavior)
+    {
+      if (state_behavior == DOpEtypes::VectorStorageType::checkpointing)
+        return DOpEtypes::VectorStorageType::fullmem;
+      return state_behavior;
+    }
+
+    /**
+     * Computes the time points that are kept as checkpoints during
+     * the solution of the state equation. The checkpoints are
+     * distributed according to the binomial schedule of
+     * Griewank and Walther (Revolve) using checkpoint_snapshots_ snapshots.
+     * The initial and the final time point are always kept.
+     */
+    void SetCheckpoints();
+
+    /**
+     * Returns the distance to the next checkpoint for the binomial
+     * schedule if steps time steps need to be reversed
+     * using snapshots snapshots (including the one at the start).
+     */
+    static unsigned int CheckpointDistance(unsigned int steps,
+                                           unsigned int snapshots);
+
+    /**
+     * Makes sure that the state is stored at all time points between
+     * from and to. Missing states are recomputed starting from the
+     * closest stored time point. In between, temporary checkpoints
+     * are placed according to the binomial schedule in the
+     * snapshots not used by other checkpoints. If the Newton method
+     * starts from an extrapolated initial guess, the state before each
+     * checkpoint is kept as well, so that the recomputed states agree with
+     * the ones of the ForwardTimeLoop.
+     *
+     * Requires that the state is registered as auxiliary state `state'.
+     */
+    void EnsureStates(unsigned int from, unsigned int to);
+
+    /**
+     * Recomputes the state at the end of the given interval from
+     * the state at its beginning.
+     *
+     * @param interval       The time interval of the step.
+     * @param build_matrix   Should the matrix be build.
+     *
+     * @return               The matrix build flag of the nonlinear solver.
+     */
+    bool RecomputeStateStep(const TimeIterator &interval, bool build_matrix);
+
     /**
      *
      * This function calulates the functional pre-values and stores them
@@ -471,6 +562,13 @@ namespace DOpE
     bool project_initial_data_ = false;
     unsigned int cost_needs_precomputations_;
 
+    unsigned int checkpoint_snapshots_;
+    unsigned int n_state_recomputations_ = 0;
+    std::vector<bool> checkpoints_;
+
+    unsigned int extrapolation_order_;
+    VECTOR initial_guess_;
+
     friend class SolutionExtractor<InstatReducedProblem<CONTROLNONLINEARSOLVER, NONLINEARSOLVER,
              CONTROLINTEGRATOR, INTEGRATOR, PROBLEM, VECTOR,dopedim, dealdim>,   VECTOR > ;
   };
@@ -489,6 +587,15 @@ namespace DOpE
          ParameterReader &param_reader)
   {
     NONLINEARSOLVER::declare_params(param_reader);
+    param_reader.SetSubsection("checkpointing parameters");
+    param_reader.declare_entry("checkpoint_snapshots", "10",
+                               Patterns::Integer(1),
+                               "Number of state snapshots kept as checkpoints if the state uses the checkpointing storage behavior. The final value and the current time step are stored in addition.");
+
+    param_reader.SetSubsection("time step control parameters");
+    param_reader.declare_entry("extrapolation_order", "0",
+                               Patterns::Integer(0,1),
+                               "Order of the polynomial extrapolation from the last two time steps used as initial guess for the Newton method in each time step of the time loops. 0 starts from the last time step solution, 1 uses linear extrapolation. The fractional step theta scheme always starts from the last time step solution.");
   }
   /******************************************************/
 
@@ -506,9 +613,9 @@ namespace DOpE
                          ReducedProblemInterface<PROBLEM, VECTOR> (OP,
                              base_priority),
                          u_(OP->GetSpaceTimeHandler(), state_behavior, param_reader),
-                         z_(OP->GetSpaceTimeHandler(), state_behavior, param_reader),
-                         du_(OP->GetSpaceTimeHandler(), state_behavior, param_reader),
-                         dz_(OP->GetSpaceTimeHandler(), state_behavior, param_reader),
+                         z_(OP->GetSpaceTimeHandler(), AuxiliaryBehavior(state_behavior), param_reader),
+                         du_(OP->GetSpaceTimeHandler(), AuxiliaryBehavior(state_behavior), param_reader),
+                         dz_(OP->GetSpaceTimeHandler(), AuxiliaryBehavior(state_behavior), param_reader),
                          integrator_(idc),
                          control_integrator_(idc),
                          nonlinear_state_solver_(integrator_, param_reader),
@@ -522,6 +629,11 @@ namespace DOpE
       gradient_reinit_ = true;
     }
     cost_needs_precomputations_=0;
+
+    param_reader.SetSubsection("checkpointing parameters");
+    checkpoint_snapshots_ = param_reader.get_integer("checkpoint_snapshots");
+    param_reader.SetSubsection("time step control parameters");
+    extrapolation_order_ = param_reader.get_integer("extrapolation_order");
   }
 
   /******************************************************/
@@ -539,9 +651,9 @@ namespace DOpE
                          ReducedProblemInterface<PROBLEM, VECTOR> (OP,
                              base_priority),
                          u_(OP->GetSpaceTimeHandler(), state_behavior, param_reader),
-                         z_(OP->GetSpaceTimeHandler(), state_behavior, param_reader),
-                         du_(OP->GetSpaceTimeHandler(), state_behavior, param_reader),
-                         dz_(OP->GetSpaceTimeHandler(), state_behavior, param_reader),
+                         z_(OP->GetSpaceTimeHandler(), AuxiliaryBehavior(state_behavior), param_reader),
+                         du_(OP->GetSpaceTimeHandler(), AuxiliaryBehavior(state_behavior), param_reader),
+                         dz_(OP->GetSpaceTimeHandler(), AuxiliaryBehavior(state_behavior), param_reader),
                          integrator_(s_idc),
                          control_integrator_(c_idc),
                          nonlinear_state_solver_(integrator_, param_reader),
@@ -555,6 +667,11 @@ namespace DOpE
       gradient_reinit_ = true;
     }
     cost_needs_precomputations_=0;
+
+    param_reader.SetSubsection("checkpointing parameters");
+    checkpoint_snapshots_ = param_reader.get_integer("checkpoint_snapshots");
+    param_reader.SetSubsection("time step control parameters");
+    extrapolation_order_ = param_reader.get_integer("extrapolation_order");
   }
 
   /******************************************************/
@@ -667,6 +784,13 @@ namespace DOpE
     this->GetProblem()->AddAuxiliaryControl(&q,"control");
     this->ForwardTimeLoop(problem,this->GetU(),"State",true);
     this->GetProblem()->DeleteAuxiliaryControl("control");
+
+    std::stringstream out;
+    this->GetOutputHandler()->InitOut(out);
+    if (this->GetU().PrintStorageInfos(out))
+      {
+        this->GetOutputHandler()->Write(out, 4 + this->GetBasePriority());
+      }
   }
   /******************************************************/
 
@@ -1658,6 +1782,16 @@ namespace DOpE
        ForwardTimeLoop(PDE &problem, StateVector<VECTOR> &sol, std::string outname, bool eval_funcs)
   {
     VECTOR u_old;
+    //Solution at the time point before u_old, used by multistep schemes
+    VECTOR u_oldold;
+    const bool multistep = (problem.GetNPreviousTimePoints() > 1);
+    bool has_oldold = false;
+    //The extrapolated initial guess for the Newton method needs u_oldold as well
+    const bool keep_oldold = multistep || extrapolation_order_ > 0;
+    double t_oldold = 0.;
+    const unsigned int n_iterations =
+      this->GetNonlinearSolver("state").GetNIterations();
+    unsigned int n_time_steps = 0;
 
     unsigned int max_timestep =
       problem.GetSpaceTimeHandler()->GetMaxTimePoint();
@@ -1667,6 +1801,23 @@ namespace DOpE
     n_dofs_per_interval =
       problem.GetSpaceTimeHandler()->GetTimeDoFHandler().GetLocalNbrOfDoFs();
     std::vector<unsigned int> local_to_global(n_dofs_per_interval);
+    if (multistep && n_dofs_per_interval != 2)
+      {
+        throw DOpEException("Multistep schemes need two time DoFs per interval.",
+                            "InstatReducedProblem::ForwardTimeLoop");
+      }
+    if (multistep && GetU().GetBehavior() == DOpEtypes::VectorStorageType::checkpointing)
+      {
+        throw DOpEException("Multistep schemes can not be used with the behavior checkpointing.",
+                            "InstatReducedProblem::ForwardTimeLoop");
+      }
+    if (GetU().GetBehavior() == DOpEtypes::VectorStorageType::checkpointing
+        && outname == "State")
+      {
+        //Old states and checkpoints belong to a different control
+        sol = 0.;
+        SetCheckpoints();
+      }
     //Storage for pre-calculated tangent functional values
     if (cost_needs_precomputations_ != 0 && outname == "Tangent")
       {
@@ -1737,6 +1888,11 @@ namespace DOpE
          != problem.GetSpaceTimeHandler()->GetTimeDoFHandler().after_last_interval(); ++it)
       {
         it.get_time_dof_indices(local_to_global);
+        if (GetU().GetBehavior() == DOpEtypes::VectorStorageType::checkpointing
+            && outname != "State")
+          {
+            EnsureStates(local_to_global[0], local_to_global[n_dofs_per_interval-1]);
+          }
         problem.SetTime(times[local_to_global[0]], local_to_global[0], it);
         sol.SetTimeDoFNumber(local_to_global[0], it);
         //TODO Test again with non-uniform time steps.
@@ -1760,30 +1916,10 @@ namespace DOpE
             sol.SetTimeDoFNumber(local_to_global[i], it);
             sol.GetSpacialVector() = 0;
 
-            this->GetProblem()->AddAuxiliaryToIntegrator(
-              this->GetIntegrator());
-
-            this->GetNonlinearSolver("state").NonlinearLastTimeEvals(problem,
-                                                                     u_old, sol.GetSpacialVector());
-
-            this->GetProblem()->DeleteAuxiliaryFromIntegrator(
-              this->GetIntegrator());
-
-            problem.SetTime(time, local_to_global[i], it);
-            this->GetProblem()->AddAuxiliaryToIntegrator(
-              this->GetIntegrator());
-            this->GetProblem()->AddPreviousAuxiliaryToIntegrator(
-              this->GetIntegrator());
-
-            build_state_matrix_
-              = this->GetNonlinearSolver("state").NonlinearSolve(problem,
-                                                                 u_old, sol.GetSpacialVector(), true,
-                                                                 build_state_matrix_);
-
-            this->GetProblem()->DeleteAuxiliaryFromIntegrator(
-              this->GetIntegrator());
-            this->GetProblem()->DeletePreviousAuxiliaryFromIntegrator(
-              this->GetIntegrator());
+            build_state_matrix_ = ForwardTimeStep(problem, it,
+                                                  local_to_global[i-1], local_to_global[i],
+                                                  u_old, has_oldold ? &u_oldold : NULL, t_oldold,
+                                                  sol.GetSpacialVector(), build_state_matrix_);
 
             this->GetOutputHandler()->Write(sol.GetSpacialVector(),
                                             outname + this->GetPostIndex(), problem.GetDoFType());
@@ -1808,10 +1944,99 @@ namespace DOpE
                 this->GetIntegrator().DeleteDomainData("state");
                 this->SetProblemType("tangent");
               } // End precomputation of values
+            n_time_steps++;
+            if (keep_oldold)
+              {
+                u_oldold = u_old;
+                t_oldold = times[local_to_global[i-1]];
+                has_oldold = true;
+              }
             //TODO do a transfer to the next grid for changing spatial meshes!
             u_old = sol.GetSpacialVector();
           }
+        if (GetU().GetBehavior() == DOpEtypes::VectorStorageType::checkpointing
+            && !checkpoints_[local_to_global[0]]
+            && !(extrapolation_order_ > 0 && checkpoints_[local_to_global[1]]))
+          {
+            //The state at the beginning of the interval is not needed anymore.
+            //With extrapolation, the state before a checkpoint is kept, so
+            //that a recomputation starts from the same initial guess.
+            GetU().Release(local_to_global[0]);
+          }
       }
+    {
+      //Shows the effect of the initial guess, e.g., of the extrapolation.
+      //The priority is above the usual printlevels of the tests.
+      std::stringstream out;
+      this->GetOutputHandler()->InitOut(out);
+      out << "\t Newton iterations: "
+          << this->GetNonlinearSolver("state").GetNIterations() - n_iterations
+          << " in " << n_time_steps << " time steps";
+      this->GetOutputHandler()->Write(out, 6 + this->GetBasePriority());
+    }
+    problem.SetNAvailableTimePoints(1);
+  }
+
+  /******************************************************/
+
+  template<typename CONTROLNONLINEARSOLVER, typename NONLINEARSOLVER,
+           typename CONTROLINTEGRATOR, typename INTEGRATOR, typename PROBLEM,
+           typename VECTOR, int dopedim, int dealdim>
+  template<typename PDE>
+  bool InstatReducedProblem<CONTROLNONLINEARSOLVER, NONLINEARSOLVER,
+       CONTROLINTEGRATOR, INTEGRATOR, PROBLEM, VECTOR, dopedim, dealdim>::
+       ForwardTimeStep(PDE &problem, const TimeIterator &interval,
+                       unsigned int dof_old, unsigned int dof_new,
+                       const VECTOR &u_old, const VECTOR *u_oldold, double t_oldold,
+                       VECTOR &u_new, bool build_matrix)
+  {
+    const bool multistep = (problem.GetNPreviousTimePoints() > 1);
+    const std::vector<double> times =
+      problem.GetSpaceTimeHandler()->GetTimes();
+
+    problem.SetTime(times[dof_old], dof_old, interval);
+    this->GetProblem()->AddAuxiliaryToIntegrator(
+      this->GetIntegrator());
+
+    problem.SetNAvailableTimePoints((multistep && u_oldold != NULL) ? 2 : 1);
+    if (multistep && u_oldold != NULL)
+      this->GetIntegrator().AddDomainData("last_last_time_solution", u_oldold);
+    this->GetNonlinearSolver("state").NonlinearLastTimeEvals(problem,
+                                                             u_old, u_new);
+    if (multistep && u_oldold != NULL)
+      this->GetIntegrator().DeleteDomainData("last_last_time_solution");
+
+    this->GetProblem()->DeleteAuxiliaryFromIntegrator(
+      this->GetIntegrator());
+
+    problem.SetTime(times[dof_new], dof_new, interval);
+    this->GetProblem()->AddAuxiliaryToIntegrator(
+      this->GetIntegrator());
+    this->GetProblem()->AddPreviousAuxiliaryToIntegrator(
+      this->GetIntegrator());
+
+    //Start the Newton method from the linear extrapolation
+    //of the last two time steps
+    const bool extrapolate = (extrapolation_order_ > 0 && u_oldold != NULL);
+    if (extrapolate)
+      {
+        const double ratio = (times[dof_new] - times[dof_old]) / (times[dof_old] - t_oldold);
+        initial_guess_ = u_old;
+        initial_guess_.sadd(1. + ratio, -ratio, *u_oldold);
+        this->GetIntegrator().AddDomainData("initial_guess", &initial_guess_);
+      }
+    build_matrix
+      = this->GetNonlinearSolver("state").NonlinearSolve(problem,
+                                                         u_old, u_new, true,
+                                                         build_matrix);
+    if (extrapolate)
+      this->GetIntegrator().DeleteDomainData("initial_guess");
+
+    this->GetProblem()->DeleteAuxiliaryFromIntegrator(
+      this->GetIntegrator());
+    this->GetProblem()->DeletePreviousAuxiliaryFromIntegrator(
+      this->GetIntegrator());
+    return build_matrix;
   }
 
   /******************************************************/
@@ -1825,6 +2050,17 @@ namespace DOpE
        BackwardTimeLoop(PDE &problem, StateVector<VECTOR> &sol, ControlVector<VECTOR> &temp_q, ControlVector<VECTOR> &temp_q_trans, std::string outname, bool eval_grads)
   {
     VECTOR u_old;
+    //Solution at the time point before u_old, used by multistep schemes
+    VECTOR u_oldold;
+    const bool multistep = (problem.GetNPreviousTimePoints() > 1);
+    bool has_oldold = false;
+    //The extrapolated initial guess for the Newton method needs u_oldold as well
+    const bool keep_oldold = multistep || extrapolation_order_ > 0;
+    double t_oldold = 0.;
+    VECTOR initial_guess;
+    const unsigned int n_iterations =
+      this->GetNonlinearSolver("adjoint").GetNIterations();
+    unsigned int n_time_steps = 0;
 
     unsigned int max_timestep =
       problem.GetSpaceTimeHandler()->GetMaxTimePoint();
@@ -1834,6 +2070,17 @@ namespace DOpE
     n_dofs_per_interval =
       problem.GetSpaceTimeHandler()->GetTimeDoFHandler().GetLocalNbrOfDoFs();
     std::vector<unsigned int> local_to_global(n_dofs_per_interval);
+    if (multistep && n_dofs_per_interval != 2)
+      {
+        throw DOpEException("Multistep schemes need two time DoFs per interval.",
+                            "InstatReducedProblem::BackwardTimeLoop");
+      }
+    const bool checkpointing = (GetU().GetBehavior() == DOpEtypes::VectorStorageType::checkpointing);
+    const unsigned int n_recomputations = n_state_recomputations_;
+    if (checkpointing)
+      {
+        EnsureStates(max_timestep-1, max_timestep);
+      }
     {
       TimeIterator it =
         problem.GetSpaceTimeHandler()->GetTimeDoFHandler().last_interval();
@@ -1900,6 +2147,12 @@ namespace DOpE
          != problem.GetSpaceTimeHandler()->GetTimeDoFHandler().before_first_interval(); --it)
       {
         it.get_time_dof_indices(local_to_global);
+        if (checkpointing)
+          {
+            //The states on the interval and the one before it are needed
+            EnsureStates(local_to_global[0] > 0 ? local_to_global[0]-1 : 0,
+                         local_to_global[n_dofs_per_interval-1]);
+          }
         problem.SetTime(times[local_to_global[local_to_global.size()-1]],local_to_global[local_to_global.size()-1], it);
         sol.SetTimeDoFNumber(local_to_global[local_to_global.size()-1], it);
         //TODO Add a test with non-uniform time steps to check whether this is correct.
@@ -1943,8 +2196,13 @@ namespace DOpE
                 }
               }
 
+            problem.SetNAvailableTimePoints((multistep && has_oldold) ? 2 : 1);
+            if (multistep && has_oldold)
+              this->GetIntegrator().AddDomainData("last_last_time_solution", &u_oldold);
             this->GetNonlinearSolver("adjoint").NonlinearLastTimeEvals(problem,
                                                                        u_old, sol.GetSpacialVector());
+            if (multistep && has_oldold)
+              this->GetIntegrator().DeleteDomainData("last_last_time_solution");
 
             this->GetProblem()->DeleteAuxiliaryFromIntegrator(
               this->GetIntegrator());
@@ -1983,10 +2241,22 @@ namespace DOpE
                 }
               }
 
+            //Start the Newton method from the linear extrapolation
+            //of the last two time steps
+            if (extrapolation_order_ > 0 && has_oldold)
+              {
+                const double t_old = times[local_to_global[j+1]];
+                const double ratio = (time - t_old) / (t_old - t_oldold);
+                initial_guess = u_old;
+                initial_guess.sadd(1. + ratio, -ratio, u_oldold);
+                this->GetIntegrator().AddDomainData("initial_guess", &initial_guess);
+              }
             build_adjoint_matrix_
               = this->GetNonlinearSolver("adjoint").NonlinearSolve(problem,
                                                                    u_old, sol.GetSpacialVector(), true,
                                                                    build_adjoint_matrix_);
+            if (extrapolation_order_ > 0 && has_oldold)
+              this->GetIntegrator().DeleteDomainData("initial_guess");
 
             this->GetProblem()->DeleteAuxiliaryFromIntegrator(
               this->GetIntegrator());
@@ -2005,6 +2275,13 @@ namespace DOpE
                 this->GetIntegrator().DeleteParamData("cost_functional_pre_tangent");
               }
 
+            n_time_steps++;
+            if (keep_oldold)
+              {
+                u_oldold = u_old;
+                t_oldold = times[local_to_global[j+1]];
+                has_oldold = true;
+              }
             //TODO do a transfer to the next grid for changing spatial meshes!
             u_old = sol.GetSpacialVector();
             this->GetOutputHandler()->Write(sol.GetSpacialVector(),
@@ -2231,7 +2508,226 @@ namespace DOpE
                   }
               }
           }//End interval loop
+        if (checkpointing && local_to_global[n_dofs_per_interval-1] != max_timestep)
+          {
+            //Passed checkpoints are released to make room for new ones,
+            //the final value is kept for the evaluation of the gradient.
+            GetU().Release(local_to_global[n_dofs_per_interval-1]);
+          }
       }//End time loop
+    if (checkpointing)
+      {
+        std::stringstream out;
+        this->GetOutputHandler()->InitOut(out);
+        out << "\t Recomputed state time steps: "
+            << n_state_recomputations_ - n_recomputations
+            << " (total: " << n_state_recomputations_ << ")";
+        this->GetOutputHandler()->Write(out, 4 + this->GetBasePriority());
+      }
+    {
+      //Shows the effect of the initial guess, e.g., of the extrapolation.
+      //The priority is above the usual printlevels of the tests.
+      std::stringstream out;
+      this->GetOutputHandler()->InitOut(out);
+      out << "\t Newton iterations: "
+          << this->GetNonlinearSolver("adjoint").GetNIterations() - n_iterations
+          << " in " << n_time_steps << " time steps";
+      this->GetOutputHandler()->Write(out, 6 + this->GetBasePriority());
+    }
+    problem.SetNAvailableTimePoints(1);
+  }
+
+  /******************************************************/
+
+  template<typename CONTROLNONLINEARSOLVER, typename NONLINEARSOLVER,
+           typename CONTROLINTEGRATOR, typename INTEGRATOR, typename PROBLEM,
+           typename VECTOR, int dopedim, int dealdim>
+  unsigned int InstatReducedProblem<CONTROLNONLINEARSOLVER, NONLINEARSOLVER,
+           CONTROLINTEGRATOR, INTEGRATOR, PROBLEM, VECTOR, dopedim, dealdim>::
+           CheckpointDistance(unsigned int steps, unsigned int snapshots)
+  {
+    if (steps <= 1 || snapshots <= 1)
+      return steps;
+    //With s snapshots and at most t recomputations of each step
+    //beta(s,t) = (s+t)!/(s!t!) steps can be reversed.
+    auto beta = [](unsigned int s, unsigned int t) -> double
+    {
+      double b = 1.;
+      for (unsigned int i = 1; i <= s; i++)
+        b = b * (t + i) / i;
+      return b;
+    };
+    unsigned int t = 0;
+    while (beta(snapshots, t) < steps)
+      t++;
+    //The part behind the new checkpoint is reversed with one snapshot less
+    double behind = beta(snapshots - 1, t);
+    if (steps > behind)
+      return steps - static_cast<unsigned int>(behind);
+    return 1;
+  }
+
+  /******************************************************/
+
+  template<typename CONTROLNONLINEARSOLVER, typename NONLINEARSOLVER,
+           typename CONTROLINTEGRATOR, typename INTEGRATOR, typename PROBLEM,
+           typename VECTOR, int dopedim, int dealdim>
+  void InstatReducedProblem<CONTROLNONLINEARSOLVER, NONLINEARSOLVER,
+       CONTROLINTEGRATOR, INTEGRATOR, PROBLEM, VECTOR, dopedim, dealdim>::
+       SetCheckpoints()
+  {
+    if (this->GetProblem()->GetSpaceTimeHandler()->GetTimeDoFHandler().GetLocalNbrOfDoFs() != 2)
+      {
+        throw DOpEException("The checkpointing behavior requires exactly two time DoFs per interval.",
+                            "InstatReducedProblem::SetCheckpoints");
+      }
+    unsigned int max_timestep =
+      this->GetProblem()->GetSpaceTimeHandler()->GetMaxTimePoint();
+    checkpoints_.assign(max_timestep + 1, false);
+    checkpoints_[0] = true;
+    checkpoints_[max_timestep] = true;
+
+    unsigned int snapshots = checkpoint_snapshots_;
+    unsigned int point = 0;
+    while (snapshots > 1 && point < max_timestep)
+      {
+        point += CheckpointDistance(max_timestep - point, snapshots);
+        snapshots--;
+        if (point < max_timestep)
+          checkpoints_[point] = true;
+      }
+  }
+
+  /******************************************************/
+
+  template<typename CONTROLNONLINEARSOLVER, typename NONLINEARSOLVER,
+           typename CONTROLINTEGRATOR, typename INTEGRATOR, typename PROBLEM,
+           typename VECTOR, int dopedim, int dealdim>
+  void InstatReducedProblem<CONTROLNONLINEARSOLVER, NONLINEARSOLVER,
+       CONTROLINTEGRATOR, INTEGRATOR, PROBLEM, VECTOR, dopedim, dealdim>::
+       EnsureStates(unsigned int from, unsigned int to)
+  {
+    const StateVector<VECTOR> &u = GetU();
+    unsigned int first_missing = from;
+    while (first_missing <= to && u.IsStored(first_missing))
+      first_missing++;
+    if (first_missing > to)
+      {
+        //Nothing to do
+        return;
+      }
+    //The initial value is always stored, so this terminates.
+    assert(first_missing > 0);
+    unsigned int start = first_missing - 1;
+    while (!u.IsStored(start))
+      start--;
+
+    //Place temporary checkpoints in the snapshots not used
+    //by the checkpoints before the requested time points.
+    std::vector<bool> keep(to + 1, false);
+    for (unsigned int t = from; t <= to; t++)
+      keep[t] = true;
+    unsigned int used = 0;
+    for (unsigned int t = 0; t < from; t++)
+      {
+        if (u.IsStored(t))
+          used++;
+      }
+    unsigned int snapshots = 1;
+    if (checkpoint_snapshots_ > used)
+      snapshots += checkpoint_snapshots_ - used;
+    unsigned int point = start;
+    while (snapshots > 1 && point < from)
+      {
+        point += CheckpointDistance(from - point, snapshots);
+        snapshots--;
+        if (point < from)
+          {
+            keep[point] = true;
+            //See ForwardTimeLoop
+            if (extrapolation_order_ > 0)
+              keep[point - 1] = true;
+          }
+      }
+
+    std::stringstream out;
+    this->GetOutputHandler()->InitOut(out);
+    out << "	 Recomputing state from time step " << start << " to " << to;
+    this->GetOutputHandler()->Write(out, 5 + this->GetBasePriority());
+
+    //Recompute with the state problem, the state itself must not
+    //be given to the integrator while it is being computed.
+    std::string type = this->GetProblem()->GetType();
+    unsigned int type_num = this->GetProblem()->GetTypeNum();
+    this->GetProblem()->DeleteAuxiliaryState("state");
+    this->SetProblemType("state");
+
+    TimeIterator it =
+      this->GetProblem()->GetSpaceTimeHandler()->GetTimeDoFHandler().first_interval();
+    for (unsigned int t = 0; t < start; t++)
+      ++it;
+    bool build_matrix = true;
+    const unsigned int lag = (extrapolation_order_ > 0) ? 2 : 1;
+    for (unsigned int t = start + 1; t <= to; t++, ++it)
+      {
+        if (!u.IsStored(t))
+          {
+            build_matrix = RecomputeStateStep(it, build_matrix);
+            n_state_recomputations_++;
+          }
+        //With extrapolation, the state at t-1 is needed again at t+1
+        if (t > start + lag && !keep[t - lag])
+          GetU().Release(t - lag);
+      }
+    if (lag == 2 && to > start + 1 && !keep[to - 1])
+      GetU().Release(to - 1);
+
+    this->SetProblemType(type, type_num);
+    this->GetProblem()->AddAuxiliaryState(&(this->GetU()), "state");
+    //The state solver is also used for the tangent problem.
+    build_state_matrix_ = true;
+  }
+
+  /******************************************************/
+
+  template<typename CONTROLNONLINEARSOLVER, typename NONLINEARSOLVER,
+           typename CONTROLINTEGRATOR, typename INTEGRATOR, typename PROBLEM,
+           typename VECTOR, int dopedim, int dealdim>
+  bool InstatReducedProblem<CONTROLNONLINEARSOLVER, NONLINEARSOLVER,
+       CONTROLINTEGRATOR, INTEGRATOR, PROBLEM, VECTOR, dopedim, dealdim>::
+       RecomputeStateStep(const TimeIterator &interval, bool build_matrix)
+  {
+    auto &problem = this->GetProblem()->GetStateProblem();
+    const std::vector<double> times =
+      problem.GetSpaceTimeHandler()->GetTimes();
+    std::vector<unsigned int> local_to_global(2);
+    interval.get_time_dof_indices(local_to_global);
+
+    const StateVector<VECTOR> &u = GetU();
+    u.SetTimeDoFNumber(local_to_global[0], interval);
+    VECTOR u_old = u.GetSpacialVector();
+    //The state before the interval is available, if the ForwardTimeLoop
+    //has used it for the extrapolated initial guess.
+    VECTOR u_oldold;
+    bool has_oldold = false;
+    if (extrapolation_order_ > 0 && local_to_global[0] > 0
+        && u.IsStored(local_to_global[0] - 1))
+      {
+        u.SetTimeDoFNumber(local_to_global[0] - 1);
+        u_oldold = u.GetSpacialVector();
+        has_oldold = true;
+      }
+
+    GetU().SetTimeDoFNumber(local_to_global[1], interval);
+    GetU().GetSpacialVector() = 0;
+
+    build_matrix = ForwardTimeStep(problem, interval,
+                                   local_to_global[0], local_to_global[1],
+                                   u_old, has_oldold ? &u_oldold : NULL,
+                                   has_oldold ? times[local_to_global[0] - 1] : 0.,
+                                   GetU().GetSpacialVector(), build_matrix);
+    problem.SetNAvailableTimePoints(1);
+    return build_matrix;
   }
 
   /******************************************************/
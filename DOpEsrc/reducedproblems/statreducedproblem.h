@@ -260,6 +260,7 @@ namespace DOpE
     StateSizeInfo(std::stringstream &out) override
     {
       GetU().PrintInfos(out);
+      this->GetProblem()->GetSpaceTimeHandler()->PrintDoFNumberingInfos(out);
     }
 
     /******************************************************/
@@ -54,6 +54,9 @@ namespace DOpE
     param_reader.declare_entry("filter_iteration","1",Patterns::Integer(1),"Only print every n-th iteration, set to one for every iteration. Use filter_time for timestep filtering");
     param_reader.declare_entry("eps_machine_set_by_user","0.0",Patterns::Double(),"Correlation of the output and machine precision");
     param_reader.declare_entry("number of patches", "0", Patterns::Integer(0));
+    param_reader.declare_entry("async_disc_buffers","0",Patterns::Integer(0),"Number of spatial vectors per SpaceTimeVector used to write and prefetch time steps in the background if the behavior store_on_disc is used, 0 means synchronous access");
+    param_reader.declare_entry("compression_tolerance","0.",Patterns::Double(0.),"Error bound relative to the maximum norm of each time step for SpaceTimeVectors with the behavior compressed, 0 means lossless compression. The reduced gradient is perturbed by about the same relative amount, so it should be well below the relative tolerance of the optimization algorithm, e.g., 0.1*nonlinear_tol");
+    param_reader.declare_entry("memory_budget","0.",Patterns::Double(0.),"Memory in MB all SpaceTimeVectors with the behavior store_on_disc may use together to keep the most recently used time steps in main memory, only the others are written to the disc. 0 means every time step is written");
 
 
   }
@@ -29,11 +29,182 @@
 #include <iostream>
 #include <assert.h>
 #include <iomanip>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+#include <type_traits>
+
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <deal.II/base/timer.h>
+#include <deal.II/base/utilities.h>
 
 using namespace dealii;
 
 namespace DOpE
 {
+  namespace
+  {
+    /**
+     * True for the vector types whose values are stored contiguously
+     * on this process, so that the mapped_file behavior can copy them
+     * as raw memory.
+     */
+    template<typename VECTOR>
+    struct IsSerialVector : std::false_type {};
+    template<typename number>
+    struct IsSerialVector<dealii::Vector<number> > : std::true_type {};
+    template<typename number>
+    struct IsSerialVector<dealii::BlockVector<number> > : std::true_type {};
+
+    /**
+     * Encodings of the time points in the compressed behavior. Each
+     * compressed time point starts with the encoding, the quantization
+     * step and the number of entries.
+     */
+    enum CompressionMode
+    {
+      lossless = 0,
+      quantized = 1
+    };
+
+    template<typename T>
+    void
+    AppendBytes(std::string &out, const T &value)
+    {
+      const char *bytes = reinterpret_cast<const char *>(&value);
+      out.append(bytes, sizeof(T));
+    }
+
+    template<typename T>
+    T
+    ReadBytes(const std::vector<char> &in, size_t &pos)
+    {
+      T value;
+      std::memcpy(&value, &in[pos], sizeof(T));
+      pos += sizeof(T);
+      return value;
+    }
+
+    /**
+     * Compresses the given vector into out. For tolerance > 0 the
+     * entries are rounded to multiples of 2*tolerance*|vector|_infty,
+     * so the error in each entry is bounded by tolerance*|vector|_infty,
+     * and the differences of neighboring entries are stored as variable
+     * length integers. Otherwise the bytes of the entries are shuffled
+     * such that the sign and exponent bytes are stored contiguously.
+     * In both cases the result is compressed with zlib by
+     * dealii::Utilities::compress.
+     */
+    template<typename VECTOR>
+    void
+    Compress(const VECTOR &vector, double tolerance, std::vector<char> &out)
+    {
+      typedef typename VECTOR::value_type value_type;
+      const unsigned long long n = std::distance(vector.begin(), vector.end());
+      double step = 0.;
+      if (tolerance > 0.)
+        {
+          const double max = vector.linfty_norm();
+          step = 2. * tolerance * max;
+          //the differences of the quantized entries need to fit into a long long
+          if (!(step > 0.) || max / step > 1.e15)
+            step = 0.;
+        }
+      std::string header;
+      AppendBytes(header, static_cast<char>(step > 0. ? quantized : lossless));
+      AppendBytes(header, step);
+      AppendBytes(header, n);
+      std::string payload;
+      if (step > 0.)
+        {
+          //zigzag encoded differences, small differences need a single byte
+          long long previous = 0;
+          for (typename VECTOR::const_iterator it = vector.begin(); it != vector.end(); ++it)
+            {
+              const long long q = std::llround(*it / step);
+              const long long d = q - previous;
+              previous = q;
+              unsigned long long z = (static_cast<unsigned long long>(d) << 1)
+                                     ^ static_cast<unsigned long long>(d >> 63);
+              while (z >= 128)
+                {
+                  payload.push_back(static_cast<char>((z & 127) | 128));
+                  z >>= 7;
+                }
+              payload.push_back(static_cast<char>(z));
+            }
+        }
+      else
+        {
+          payload.resize(n * sizeof(value_type));
+          size_t i = 0;
+          for (typename VECTOR::const_iterator it = vector.begin(); it != vector.end(); ++it, ++i)
+            {
+              const char *bytes = reinterpret_cast<const char *>(&*it);
+              for (size_t k = 0; k < sizeof(value_type); k++)
+                payload[k * n + i] = bytes[k];
+            }
+        }
+      const std::string compressed = Utilities::compress(payload);
+      out.assign(header.begin(), header.end());
+      out.insert(out.end(), compressed.begin(), compressed.end());
+    }
+
+    /**
+     * Inverse of Compress. Returns false if the number of entries does
+     * not match the size of the vector.
+     */
+    template<typename VECTOR>
+    bool
+    Decompress(const std::vector<char> &in, VECTOR &vector)
+    {
+      typedef typename VECTOR::value_type value_type;
+      size_t pos = 0;
+      const char mode = ReadBytes<char>(in, pos);
+      const double step = ReadBytes<double>(in, pos);
+      const unsigned long long n = ReadBytes<unsigned long long>(in, pos);
+      if (n != static_cast<unsigned long long>(std::distance(vector.begin(), vector.end())))
+        return false;
+      const std::string payload =
+        Utilities::decompress(std::string(in.begin() + pos, in.end()));
+      if (mode == quantized)
+        {
+          size_t p = 0;
+          long long previous = 0;
+          for (typename VECTOR::iterator it = vector.begin(); it != vector.end(); ++it)
+            {
+              unsigned long long z = 0;
+              unsigned int shift = 0;
+              unsigned char c;
+              do
+                {
+                  c = static_cast<unsigned char>(payload[p++]);
+                  z |= static_cast<unsigned long long>(c & 127) << shift;
+                  shift += 7;
+                }
+              while (c & 128);
+              previous += static_cast<long long>(z >> 1) ^ -static_cast<long long>(z & 1);
+              *it = previous * step;
+            }
+        }
+      else
+        {
+          assert(payload.size() == n * sizeof(value_type));
+          size_t i = 0;
+          for (typename VECTOR::iterator it = vector.begin(); it != vector.end(); ++it, ++i)
+            {
+              char *bytes = reinterpret_cast<char *>(&*it);
+              for (size_t k = 0; k < sizeof(value_type); k++)
+                bytes[k] = payload[k * n + i];
+            }
+        }
+      return true;
+    }
+  }
+
   /******************************************************/
   /**
    * Definition of static member variables
@@ -42,6 +213,10 @@ namespace DOpE
   unsigned int SpaceTimeVector<VECTOR>::id_counter_ = 0;
   template<typename VECTOR>
   unsigned int SpaceTimeVector<VECTOR>::num_active_ = 0;
+  template<typename VECTOR>
+  std::list<std::pair<const SpaceTimeVector<VECTOR> *, unsigned int> > SpaceTimeVector<VECTOR>::cache_list_;
+  template<typename VECTOR>
+  size_t SpaceTimeVector<VECTOR>::total_cache_bytes_ = 0;
 
   /******************************************************/
   template<typename VECTOR>
@@ -54,8 +229,17 @@ namespace DOpE
     STH_ = ref.GetSpaceTimeHandler();
     sfh_ticket_ = 0;
     tmp_dir_ = ref.tmp_dir_;
+    n_async_buffers_ = ref.n_async_buffers_;
+    memory_budget_ = ref.memory_budget_;
+    cache_bytes_ = 0;
+    cache_hits_ = 0;
+    cache_misses_ = 0;
+    compression_tolerance_ = ref.compression_tolerance_;
+    compression_time_ = 0.;
+    decompression_time_ = 0.;
+    last_time_point_ = -1;
     accessor_index_ = 0;
-    if (behavior_ == DOpEtypes::VectorStorageType::store_on_disc)
+    if (IsSerialized())
       {
         local_vectors_.resize(1, NULL);
         local_vectors_[0] = new VECTOR;
@@ -65,6 +249,8 @@ namespace DOpE
     id_counter_++;
     current_dof_number_ = 0;
     accessor_=0;
+    mapping_ = NULL;
+    mapping_fd_ = -1;
 
     ReInit();
   }
@@ -85,6 +271,19 @@ namespace DOpE
     sfh_ticket_ = 0;
     param_reader.SetSubsection("output parameters");
     tmp_dir_ = param_reader.get_string("results_dir") + "tmp_"+DOpEtypesToString(vector_type_)+"/";
+    n_async_buffers_ = 0;
+    if (behavior_ == DOpEtypes::VectorStorageType::store_on_disc)
+      n_async_buffers_ = param_reader.get_integer("async_disc_buffers");
+    memory_budget_ = 0;
+    if (behavior_ == DOpEtypes::VectorStorageType::store_on_disc)
+      memory_budget_ = static_cast<size_t>(param_reader.get_double("memory_budget") * 1048576.);
+    cache_bytes_ = 0;
+    cache_hits_ = 0;
+    cache_misses_ = 0;
+    compression_tolerance_ = param_reader.get_double("compression_tolerance");
+    compression_time_ = 0.;
+    decompression_time_ = 0.;
+    last_time_point_ = -1;
     //Check if expectation on combination of args is given
     if ( GetType() == DOpEtypes::VectorType::state )
       {
@@ -107,7 +306,8 @@ namespace DOpE
                                     "SpaceTimeVector<VECTOR>::SpaceTimeVector<VECTOR>");
               }
           }
-        if (behavior_ == DOpEtypes::VectorStorageType::only_recent)
+        if (behavior_ == DOpEtypes::VectorStorageType::only_recent
+            || behavior_ == DOpEtypes::VectorStorageType::checkpointing)
           {
             throw DOpEException("Storage behavior: " + DOpEtypesToString(GetBehavior()) +
                                 " makes no sense for VectorType" + DOpEtypesToString(GetType()),
@@ -115,37 +315,55 @@ namespace DOpE
           }
 
       }
+#if !DEAL_II_VERSION_GTE(9,0,0)
+    if (behavior_ == DOpEtypes::VectorStorageType::compressed)
+      {
+        throw DOpEException("Storage behavior: " + DOpEtypesToString(GetBehavior()) +
+                            " needs Utilities::compress from deal.II 9.0 or newer.",
+                            "SpaceTimeVector<VECTOR>::SpaceTimeVector<VECTOR>");
+      }
+#endif
+    if (behavior_ == DOpEtypes::VectorStorageType::mapped_file
+        && !IsSerialVector<VECTOR>::value)
+      {
+        throw DOpEException("Storage behavior: " + DOpEtypesToString(GetBehavior()) +
+                            " is only available for serial vectors.",
+                            "SpaceTimeVector<VECTOR>::SpaceTimeVector<VECTOR>");
+      }
     //Continue initialization
-    if (behavior_ == DOpEtypes::VectorStorageType::store_on_disc)
+    if (IsSerialized())
       {
-        //make the directory
-        std::string command = "mkdir -p " + tmp_dir_;
-        if (system(command.c_str()) != 0)
-          {
-            throw DOpEException("The command " + command + "failed!",
-                                "SpaceTimeVector<VECTOR>::SpaceTimeVector");
-          }
-        //check that the directory is not alredy in use by the program
-        if (num_active_ == 0)
+        if (GetBehavior() != DOpEtypes::VectorStorageType::compressed)
           {
-            filename_ = tmp_dir_ + "SpaceTimeVector_lock";
-            assert(!filestream_.is_open());
-            filestream_.open(filename_.c_str(), std::fstream::in);
-            if (!filestream_.fail())
+            //make the directory
+            std::string command = "mkdir -p " + tmp_dir_;
+            if (system(command.c_str()) != 0)
               {
-                filestream_.close();
-                throw DOpEException(
-                  "The directory " + tmp_dir_
-                  + " is probably already in use.",
-                  "SpaceTimeVector<VECTOR>::SpaceTimeVector");
+                throw DOpEException("The command " + command + "failed!",
+                                    "SpaceTimeVector<VECTOR>::SpaceTimeVector");
               }
-            else
+            //check that the directory is not alredy in use by the program
+            if (num_active_ == 0)
               {
-                command = "touch " + tmp_dir_ + "SpaceTimeVector_lock";
-                if (system(command.c_str()) != 0)
+                filename_ = tmp_dir_ + "SpaceTimeVector_lock";
+                assert(!filestream_.is_open());
+                filestream_.open(filename_.c_str(), std::fstream::in);
+                if (!filestream_.fail())
                   {
-                    throw DOpEException("The command " + command + "failed!",
-                                        "SpaceTimeVector<VECTOR>::SpaceTimeVector");
+                    filestream_.close();
+                    throw DOpEException(
+                      "The directory " + tmp_dir_
+                      + " is probably already in use.",
+                      "SpaceTimeVector<VECTOR>::SpaceTimeVector");
+                  }
+                else
+                  {
+                    command = "touch " + tmp_dir_ + "SpaceTimeVector_lock";
+                    if (system(command.c_str()) != 0)
+                      {
+                        throw DOpEException("The command " + command + "failed!",
+                                            "SpaceTimeVector<VECTOR>::SpaceTimeVector");
+                      }
                   }
               }
           }
@@ -158,6 +376,8 @@ namespace DOpE
     num_active_++;
     current_dof_number_ = 0;
     accessor_=0;
+    mapping_ = NULL;
+    mapping_fd_ = -1;
     ReInit();
   }
 
@@ -216,21 +436,55 @@ namespace DOpE
                 SetTimeDoFNumber(0);
               }
           }
+        else if (GetBehavior() == DOpEtypes::VectorStorageType::checkpointing)
+          {
+            //Nothing is allocated here. The spatial vectors are created
+            //when they are written for the first time and the old
+            //values are invalid after a change of the mesh anyhow.
+            for (unsigned int t = 0; t < stvector_.size(); t++)
+              {
+                if (stvector_[t] != NULL)
+                  {
+                    delete stvector_[t];
+                    stvector_[t] = NULL;
+                  }
+              }
+            stvector_.resize(GetSpaceTimeHandler()->GetMaxTimePoint() + 1, NULL);
+          }
         else
           {
-            if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
+            if (IsSerialized())
               {
+                //no background task may write an old file after this
+                CacheClear();
+                AsyncWaitAll();
+                last_time_point_ = -1;
                 stvector_information_.clear();
                 stvector_information_.resize(
                   GetSpaceTimeHandler()->GetMaxTimePoint() + 1);
 
-                //delete all old DOpE-Files in the directory
-                std::string command = "rm -f " + tmp_dir_ + "*."
-                                      + Utilities::int_to_string(unique_id_) + ".dope";
-                if (system(command.c_str()) != 0)
+                if (GetBehavior() == DOpEtypes::VectorStorageType::compressed)
+                  {
+                    compressed_.clear();
+                    compressed_.resize(GetSpaceTimeHandler()->GetMaxTimePoint() + 1);
+                  }
+                else
                   {
-                    throw DOpEException("The command " + command + "failed!",
-                                        "SpaceTimeVector<VECTOR>::ReInit");
+                    //delete all old DOpE-Files in the directory
+                    UnmapFile();
+                    std::string command = "rm -f " + tmp_dir_ + "*."
+                                          + Utilities::int_to_string(unique_id_) + ".dope";
+                    if (system(command.c_str()) != 0)
+                      {
+                        throw DOpEException("The command " + command + "failed!",
+                                            "SpaceTimeVector<VECTOR>::ReInit");
+                      }
+                  }
+                if (GetBehavior() == DOpEtypes::VectorStorageType::mapped_file)
+                  {
+                    MapFile();
+                    //The old local vectors do not fit into the new slots
+                    accessor_ = -1;
                   }
                 for (unsigned int t = 0; t
                      <= GetSpaceTimeHandler()->GetMaxTimePoint(); t++)
@@ -265,15 +519,30 @@ namespace DOpE
             delete stvector_[i];
           }
       }
+    else if (GetBehavior() == DOpEtypes::VectorStorageType::checkpointing)
+      {
+        for (unsigned int i = 0; i < stvector_.size(); i++)
+          {
+            if (stvector_[i] != NULL)
+              delete stvector_[i];
+          }
+      }
     else
       {
-        if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
+        if (IsSerialized())
           {
             for (unsigned int i = 0; i < local_vectors_.size(); i++)
               {
                 assert(local_vectors_[i] != NULL);
                 delete local_vectors_[i];
               }
+            CacheClear();
+            AsyncWaitAll();
+            for (unsigned int i = 0; i < async_free_.size(); i++)
+              {
+                delete async_free_[i];
+              }
+            UnmapFile();
             if (1 == num_active_)
               {
                 std::string command = "rm -f " + tmp_dir_ + "*."
@@ -313,13 +582,14 @@ namespace DOpE
                                             const TimeIterator &interval) const
   {
     if (GetBehavior() == DOpEtypes::VectorStorageType::fullmem
-        || GetBehavior() == DOpEtypes::VectorStorageType::only_recent)
+        || GetBehavior() == DOpEtypes::VectorStorageType::only_recent
+        || GetBehavior() == DOpEtypes::VectorStorageType::checkpointing)
       {
         this->SetTimeDoFNumber(dof_number);
       }
     else
       {
-        if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
+        if (IsSerialized())
           {
             assert(GetAction() == DOpEtypes::VectorAction::nonstationary);
             //check, if we have already loaded the interval
@@ -378,14 +648,15 @@ namespace DOpE
                 throw DOpEException("Invalid movement in time. Using the only_recent behavior you may only move forward in time by exatly one time_dof per update. To reset the time to the initial value call the ReInit method of this vector.","SpaceTimeVector::SetTimeDoFNumber");
               }
           }
-        else if (GetBehavior() == DOpEtypes::VectorStorageType::fullmem)
+        else if (GetBehavior() == DOpEtypes::VectorStorageType::fullmem
+                 || GetBehavior() == DOpEtypes::VectorStorageType::checkpointing)
           {
             accessor_ = static_cast<int> (time_point);
             assert(accessor_ < static_cast<int>(stvector_.size()));
           }
         else
           {
-            if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
+            if (IsSerialized())
               {
                 StoreOnDisc();
                 accessor_ = time_point;
@@ -402,6 +673,7 @@ namespace DOpE
                   }
                 stvector_information_.at(time_point).size_
                   = local_vectors_[global_to_local_[accessor_]]->size();
+                AsyncReadAhead(time_point, time_point);
               }
             else
               {
@@ -445,9 +717,21 @@ namespace DOpE
             else
               return local_stvector_;
           }
+        else if (GetBehavior() == DOpEtypes::VectorStorageType::checkpointing)
+          {
+            if (accessor_ >= 0)
+              {
+                //Writing access, so the time point is stored from now on.
+                if (stvector_[accessor_] == NULL)
+                  ReSizeSpace(accessor_);
+                return *(stvector_[accessor_]);
+              }
+            else
+              return local_stvector_;
+          }
         else
           {
-            if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
+            if (IsSerialized())
               {
                 if (accessor_ >= 0)
                   {
@@ -492,9 +776,16 @@ namespace DOpE
             else
               return local_stvector_;
           }
+        else if (GetBehavior() == DOpEtypes::VectorStorageType::checkpointing)
+          {
+            if (accessor_ >= 0)
+              return GetCheckpoint(accessor_, "SpaceTimeVector<VECTOR>::GetSpacialVector const");
+            else
+              return local_stvector_;
+          }
         else
           {
-            if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
+            if (IsSerialized())
               {
                 if (accessor_ >= 0)
                   {
@@ -542,9 +833,17 @@ namespace DOpE
               throw DOpEException("Case should not occure!",
                                   "SpaceTimeVector<VECTOR>::GetSpacialVectorWithTemporalTransfer const");
           }
+        else if (GetBehavior() == DOpEtypes::VectorStorageType::checkpointing)
+          {
+            if (accessor_ >= 0)
+              local_stvector_ = GetCheckpoint(accessor_, "SpaceTimeVector<VECTOR>::GetSpacialVectorWithTemporalTransfer const");
+            else
+              throw DOpEException("Case should not occure!",
+                                  "SpaceTimeVector<VECTOR>::GetSpacialVectorWithTemporalTransfer const");
+          }
         else
           {
-            if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
+            if (IsSerialized())
               {
                 if (accessor_ >= 0)
                   {
@@ -604,9 +903,17 @@ namespace DOpE
               throw DOpEException("No Previous Vector Available ",
                                   "SpaceTimeVector<VECTOR>::GetPreviousSpacialVectorWithTemporalTransfer const");
           }
+        else if (GetBehavior() == DOpEtypes::VectorStorageType::checkpointing)
+          {
+            if (accessor_ > 0)
+              local_stvector_ = GetCheckpoint(accessor_-1, "SpaceTimeVector<VECTOR>::GetPreviousSpacialVectorWithTemporalTransfer const");
+            else
+              throw DOpEException("No Previous Vector Available ",
+                                  "SpaceTimeVector<VECTOR>::GetPreviousSpacialVectorWithTemporalTransfer const");
+          }
         else
           {
-            if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
+            if (IsSerialized())
               {
                 if (accessor_ >= 0)
                   {
@@ -656,9 +963,16 @@ namespace DOpE
                             "SpaceTimeVector<VECTOR>::GetNextSpacialVector");
         abort();
       }
+    else if (GetBehavior() == DOpEtypes::VectorStorageType::checkpointing)
+      {
+        if (accessor_ >= 0 && accessor_ +1 < (int) stvector_.size())
+          return GetCheckpoint(accessor_+1, "SpaceTimeVector<VECTOR>::GetNextSpacialVector");
+        throw DOpEException("No Next Vector Available ",
+                            "SpaceTimeVector<VECTOR>::GetNextSpacialVector");
+      }
     else
       {
-        if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
+        if (IsSerialized())
           {
             if (accessor_ >= 0 && global_to_local_.find(accessor_ +1) !=global_to_local_.end())
               {
@@ -697,9 +1011,16 @@ namespace DOpE
                             "SpaceTimeVector<VECTOR>::GetNextSpacialVector const");
         abort();
       }
+    else if (GetBehavior() == DOpEtypes::VectorStorageType::checkpointing)
+      {
+        if (accessor_ >= 0 && accessor_ +1 < (int) stvector_.size())
+          return GetCheckpoint(accessor_+1, "SpaceTimeVector<VECTOR>::GetNextSpacialVector const");
+        throw DOpEException("No Next Vector Available ",
+                            "SpaceTimeVector<VECTOR>::GetNextSpacialVector const");
+      }
     else
       {
-        if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
+        if (IsSerialized())
           {
             if (accessor_ >= 0 && global_to_local_.find(accessor_ +1) !=global_to_local_.end())
               {
@@ -738,9 +1059,16 @@ namespace DOpE
                             "SpaceTimeVector<VECTOR>::GetPreviousSpacialVector");
         abort();
       }
+    else if (GetBehavior() == DOpEtypes::VectorStorageType::checkpointing)
+      {
+        if (accessor_ > 0 )
+          return GetCheckpoint(accessor_-1, "SpaceTimeVector<VECTOR>::GetPreviousSpacialVector");
+        throw DOpEException("No Previous Vector Available ",
+                            "SpaceTimeVector<VECTOR>::GetPreviousSpacialVector");
+      }
     else
       {
-        if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
+        if (IsSerialized())
           {
             if (accessor_ > 0 )
               {
@@ -779,9 +1107,16 @@ namespace DOpE
                             "SpaceTimeVector<VECTOR>::GetPreviousSpacialVector const");
         abort();
       }
+    else if (GetBehavior() == DOpEtypes::VectorStorageType::checkpointing)
+      {
+        if (accessor_ > 0 )
+          return GetCheckpoint(accessor_-1, "SpaceTimeVector<VECTOR>::GetPreviousSpacialVector const");
+        throw DOpEException("No Previous Vector Available ",
+                            "SpaceTimeVector<VECTOR>::GetPreviousSpacialVector const");
+      }
     else
       {
-        if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
+        if (IsSerialized())
           {
             if (accessor_ > 0 )
               {
@@ -829,9 +1164,16 @@ namespace DOpE
             else
               copy_stvector_ = local_stvector_;
           }
+        else if (GetBehavior() == DOpEtypes::VectorStorageType::checkpointing)
+          {
+            if (accessor_ >= 0)
+              copy_stvector_ = GetCheckpoint(accessor_, "SpaceTimeVector<VECTOR>::GetSpacialVectorCopy");
+            else
+              copy_stvector_ = local_stvector_;
+          }
         else
           {
-            if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
+            if (IsSerialized())
               {
                 if (accessor_ >= 0)
                   {
@@ -888,9 +1230,24 @@ namespace DOpE
               }
             //We don't reset the time here!
           }
+        else if (GetBehavior() == DOpEtypes::VectorStorageType::checkpointing)
+          {
+            //Only usefull to initialize with zero, which
+            //means that no time point is stored anymore.
+            if (value != 0.)
+              {
+                throw DOpEException("Using this function with any value other than zero is not supported in the checkpointing behavior",
+                                    "SpaceTimeVector::operator=");
+              }
+            for (unsigned int i = 0; i < stvector_.size(); i++)
+              {
+                Release(i);
+              }
+            SetTimeDoFNumber(0);
+          }
         else
           {
-            if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
+            if (IsSerialized())
               {
                 for (unsigned int t = 0; t
                      <= GetSpaceTimeHandler()->GetMaxTimePoint(); t++)
@@ -966,11 +1323,62 @@ namespace DOpE
                 throw DOpEException("Using this function is not supported in the only_recent behavior",
                                     "SpaceTimeVector::operator=");
               }
+            else if (GetBehavior() == DOpEtypes::VectorStorageType::checkpointing)
+              {
+                //Only the time points stored in dq are copied,
+                //all others are released.
+                for (unsigned int i = 0; i < stvector_.size(); i++)
+                  {
+                    Release(i);
+                  }
+                stvector_.resize(dq.stvector_.size(), NULL);
+                for (unsigned int i = 0; i < stvector_.size(); i++)
+                  {
+                    if (dq.stvector_[i] != NULL)
+                      stvector_[i] = new VECTOR(*(dq.stvector_[i]));
+                  }
+                SetTimeDoFNumber(0);
+              }
+            else if (GetBehavior() == DOpEtypes::VectorStorageType::mapped_file)
+              {
+                dq.StoreOnDisc();
+                if (dq.mapping_offsets_ != mapping_offsets_)
+                  {
+                    throw DOpEException("The time points of dq and this vector do not match.",
+                                        "SpaceTimeVector<VECTOR>::operator=");
+                  }
+                if (mapping_ != NULL)
+                  std::memcpy(mapping_, dq.mapping_, mapping_offsets_.back());
+                for (unsigned int t = 0; t < stvector_information_.size(); t++)
+                  {
+                    stvector_information_.at(t).on_disc_ = dq.stvector_information_.at(t).on_disc_;
+                  }
+                //Make sure that no old spatial vectores are stored in local_vectors_.
+                ResizeLocalVectors(1);
+                accessor_ = -1; //We set this so that SetTimeDoFNumber(0) does not store something!
+                SetTimeDoFNumber(0);
+              }
+            else if (GetBehavior() == DOpEtypes::VectorStorageType::compressed)
+              {
+                dq.StoreOnDisc();
+                assert(dq.compressed_.size() == compressed_.size());
+                compressed_ = dq.compressed_;
+                for (unsigned int t = 0; t < stvector_information_.size(); t++)
+                  {
+                    stvector_information_.at(t).on_disc_ = dq.stvector_information_.at(t).on_disc_;
+                  }
+                //Make sure that no old spatial vectores are stored in local_vectors_.
+                ResizeLocalVectors(1);
+                accessor_ = -1; //We set this so that SetTimeDoFNumber(0) does not store something!
+                SetTimeDoFNumber(0);
+              }
             else
               {
                 if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
                   {
                     //Delete all vectors on the disc.
+                    CacheClear();
+                    AsyncWaitAll();
                     std::string command = "mkdir -p " + tmp_dir_ + "; rm -f "
                                           + tmp_dir_ + "*." + Utilities::int_to_string(
                                             unique_id_) + ".dope";
@@ -982,6 +1390,8 @@ namespace DOpE
                       }
                     //make sure that all Vectors of dq are stored on the disc
                     dq.StoreOnDisc();
+                    dq.CacheFlush();
+                    dq.AsyncWaitAll();
                     for (unsigned int t = 0; t
                          <= dq.GetSpaceTimeHandler()->GetMaxTimePoint(); t++)
                       {
@@ -1053,9 +1463,24 @@ namespace DOpE
                 throw DOpEException("Using this function is not supported in the only_recent behavior",
                                     "SpaceTimeVector::operator+=");
               }
+            else if (GetBehavior() == DOpEtypes::VectorStorageType::checkpointing)
+              {
+                assert(dq.stvector_.size() == stvector_.size());
+                for (unsigned int i = 0; i < stvector_.size(); i++)
+                  {
+                    if (IsStored(i) != dq.IsStored(i))
+                      {
+                        throw DOpEException("The stored time points of dq and this vector do not match.",
+                                            "SpaceTimeVector<VECTOR>::operator+=");
+                      }
+                    if (stvector_[i] != NULL)
+                      stvector_[i]->operator+=(*(dq.stvector_[i]));
+                  }
+                SetTimeDoFNumber(0);
+              }
             else
               {
-                if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
+                if (IsSerialized())
                   {
                     assert(dq.GetSpaceTimeHandler()->GetMaxTimePoint() == GetSpaceTimeHandler()->GetMaxTimePoint() );
                     dq.StoreOnDisc();
@@ -1114,9 +1539,18 @@ namespace DOpE
             throw DOpEException("Using this function is not supported in the only_recent behavior",
                                 "SpaceTimeVector::operator*=");
           }
+        else if (GetBehavior() == DOpEtypes::VectorStorageType::checkpointing)
+          {
+            for (unsigned int i = 0; i < stvector_.size(); i++)
+              {
+                if (stvector_[i] != NULL)
+                  stvector_[i]->operator*=(value);
+              }
+            SetTimeDoFNumber(0);
+          }
         else
           {
-            if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
+            if (IsSerialized())
               {
                 for (unsigned int t = 0; t
                      <= GetSpaceTimeHandler()->GetMaxTimePoint(); t++)
@@ -1161,7 +1595,24 @@ namespace DOpE
             throw DOpEException("Using this function is not supported in the only_recent behavior",
                                 "SpaceTimeVector::operator*");
           }
-        if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
+        if (GetBehavior() == DOpEtypes::VectorStorageType::checkpointing)
+          {
+            assert(dq.stvector_.size() == stvector_.size());
+
+            double ret = 0.;
+            for (unsigned int i = 0; i < stvector_.size(); i++)
+              {
+                if (IsStored(i) != dq.IsStored(i))
+                  {
+                    throw DOpEException("The stored time points of dq and this vector do not match.",
+                                        "SpaceTimeVector<VECTOR>::operator*");
+                  }
+                if (stvector_[i] != NULL)
+                  ret += stvector_[i]->operator*(*(dq.stvector_[i]));
+              }
+            return ret;
+          }
+        if (IsSerialized())
           {
             if (lock_ || dq.lock_)
               {
@@ -1240,9 +1691,24 @@ namespace DOpE
                 throw DOpEException("Using this function is not supported in the only_recent behavior",
                                     "SpaceTimeVector::add");
               }
+            else if (GetBehavior() == DOpEtypes::VectorStorageType::checkpointing)
+              {
+                assert(dq.stvector_.size() == stvector_.size());
+                for (unsigned int i = 0; i < stvector_.size(); i++)
+                  {
+                    if (IsStored(i) != dq.IsStored(i))
+                      {
+                        throw DOpEException("The stored time points of dq and this vector do not match.",
+                                            "SpaceTimeVector<VECTOR>::add");
+                      }
+                    if (stvector_[i] != NULL)
+                      stvector_[i]->add(s, *(dq.stvector_[i]));
+                  }
+                SetTimeDoFNumber(0);
+              }
             else
               {
-                if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
+                if (IsSerialized())
                   {
                     assert(dq.GetSpaceTimeHandler()->GetMaxTimePoint() == GetSpaceTimeHandler()->GetMaxTimePoint() );
 
@@ -1306,9 +1772,27 @@ namespace DOpE
                 throw DOpEException("Using this function is not supported in the only_recent behavior",
                                     "SpaceTimeVector::equ");
               }
+            else if (GetBehavior() == DOpEtypes::VectorStorageType::checkpointing)
+              {
+                assert(dq.stvector_.size() == stvector_.size());
+                for (unsigned int i = 0; i < stvector_.size(); i++)
+                  {
+                    if (dq.stvector_[i] != NULL)
+                      {
+                        if (stvector_[i] == NULL)
+                          stvector_[i] = new VECTOR(*(dq.stvector_[i]));
+                        else
+                          *(stvector_[i]) = *(dq.stvector_[i]);
+                        stvector_[i]->operator*=(s);
+                      }
+                    else
+                      Release(i);
+                  }
+                SetTimeDoFNumber(0);
+              }
             else
               {
-                if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
+                if (IsSerialized())
                   {
                     dq.StoreOnDisc();
                     for (unsigned int t = 0; t
@@ -1638,9 +2122,17 @@ namespace DOpE
             assert(stvector_.size()==1);
             out << "\t" << stvector_[0]->size() << std::endl;
           }
+        else if (GetBehavior() == DOpEtypes::VectorStorageType::checkpointing)
+          {
+            assert(stvector_.size()==1);
+            if (IsStored(0))
+              out << "\t" << stvector_[0]->size() << std::endl;
+            else
+              out << "\t" << 0 << std::endl;
+          }
         else
           {
-            if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
+            if (IsSerialized())
               {
                 SetTimeDoFNumber(0);
                 out << "\t" << local_vectors_[0]->size() << std::endl;
@@ -1681,9 +2173,21 @@ namespace DOpE
             this_size = stvector_[accessor_]->size();
             out << "\tSpatial DoFs: " << this_size << std::endl;
           }
+        else if (GetBehavior() == DOpEtypes::VectorStorageType::checkpointing)
+          {
+            out << "\tNumber of Timepoints: " << stvector_.size() << std::endl;
+            out << "\tStored Timepoints: " << GetNStored() << std::endl;
+            unsigned int total_dofs = 0;
+            for (unsigned int i = 0; i < stvector_.size(); i++)
+              {
+                if (stvector_[i] != NULL)
+                  total_dofs += stvector_[i]->size();
+              }
+            out << "\tStored  DoFs: " << total_dofs << std::endl;
+          }
         else
           {
-            if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
+            if (IsSerialized())
               {
                 out << "\tNumber of Timepoints: "
                     << stvector_information_.size() << std::endl;
@@ -1713,6 +2217,113 @@ namespace DOpE
       }
   }
 
+  /******************************************************/
+  template<typename VECTOR>
+  bool
+  SpaceTimeVector<VECTOR>::IsStored(unsigned int time_point) const
+  {
+    if (GetBehavior() == DOpEtypes::VectorStorageType::checkpointing)
+      {
+        assert(time_point < stvector_.size());
+        return (stvector_[time_point] != NULL);
+      }
+    return true;
+  }
+
+  /******************************************************/
+  template<typename VECTOR>
+  void
+  SpaceTimeVector<VECTOR>::Release(unsigned int time_point)
+  {
+    if (GetBehavior() != DOpEtypes::VectorStorageType::checkpointing)
+      {
+        throw DOpEException("Release is only supported in the checkpointing behavior, not in "
+                            + DOpEtypesToString(GetBehavior()),
+                            "SpaceTimeVector<VECTOR>::Release");
+      }
+    if (lock_)
+      {
+        throw DOpEException(
+          "Trying to use Release while a copy is in use!",
+          "SpaceTimeVector::Release");
+      }
+    assert(time_point < stvector_.size());
+    if (stvector_[time_point] != NULL)
+      {
+        delete stvector_[time_point];
+        stvector_[time_point] = NULL;
+      }
+  }
+
+  /******************************************************/
+  template<typename VECTOR>
+  unsigned int
+  SpaceTimeVector<VECTOR>::GetNStored() const
+  {
+    if (GetBehavior() != DOpEtypes::VectorStorageType::checkpointing)
+      {
+        return stvector_.size();
+      }
+    unsigned int n = 0;
+    for (unsigned int i = 0; i < stvector_.size(); i++)
+      {
+        if (stvector_[i] != NULL)
+          n++;
+      }
+    return n;
+  }
+
+  /******************************************************/
+  template<typename VECTOR>
+  bool
+  SpaceTimeVector<VECTOR>::PrintStorageInfos(std::stringstream &out) const
+  {
+    if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc
+        && memory_budget_ > 0)
+      {
+        out << "\t Cached time steps: " << cache_index_.size()
+            << " (" << cache_bytes_ / 1048576. << " MB)"
+            << ", hits: " << cache_hits_ << ", misses: " << cache_misses_;
+        return true;
+      }
+    if (GetBehavior() != DOpEtypes::VectorStorageType::compressed)
+      {
+        return false;
+      }
+    double raw_bytes = 0.;
+    double compressed_bytes = 0.;
+    for (unsigned int t = 0; t < compressed_.size(); t++)
+      {
+        if (stvector_information_.at(t).on_disc_)
+          {
+            raw_bytes += stvector_information_.at(t).size_ * sizeof(typename VECTOR::value_type);
+            compressed_bytes += compressed_[t].size();
+          }
+      }
+    out << "\t Compressed time steps: " << compressed_bytes / 1048576. << " MB";
+    if (compressed_bytes > 0.)
+      out << " (ratio " << raw_bytes / compressed_bytes << ")";
+    out << ", compression: " << compression_time_ << " s"
+        << ", decompression: " << decompression_time_ << " s";
+    return true;
+  }
+
+  /******************************************************/
+  template<typename VECTOR>
+  VECTOR &
+  SpaceTimeVector<VECTOR>::GetCheckpoint(int time_point, const std::string &caller) const
+  {
+    assert(GetBehavior() == DOpEtypes::VectorStorageType::checkpointing);
+    assert(time_point >= 0 && time_point < static_cast<int>(stvector_.size()));
+    if (stvector_[time_point] == NULL)
+      {
+        throw DOpEException("The time point " + Utilities::int_to_string(time_point)
+                            + " is currently not stored. It needs to be recomputed from a checkpoint first.",
+                            caller);
+      }
+    return *(stvector_[time_point]);
+  }
+
   /******************************************************/
   template<typename VECTOR>
   bool
@@ -1725,10 +2336,18 @@ namespace DOpE
   template<typename VECTOR>
   void
   SpaceTimeVector<VECTOR>::MakeName(unsigned int time_point) const
+  {
+    filename_ = FileName(time_point);
+  }
+
+  /******************************************************/
+  template<typename VECTOR>
+  std::string
+  SpaceTimeVector<VECTOR>::FileName(unsigned int time_point) const
   {
     assert(time_point<100000);
-    filename_ = tmp_dir_ +DOpEtypesToString(vector_type_)+"vector." + Utilities::int_to_string(
-                  time_point, 5) + "." + Utilities::int_to_string(unique_id_) + ".dope";
+    return tmp_dir_ +DOpEtypesToString(vector_type_)+"vector." + Utilities::int_to_string(
+             time_point, 5) + "." + Utilities::int_to_string(unique_id_) + ".dope";
   }
 
   /******************************************************/
@@ -1737,36 +2356,211 @@ namespace DOpE
   SpaceTimeVector<VECTOR>::StoreOnDisc() const
   {
     //make sure that accessor has the chance to indicate sth valid
-    if (accessor_ >= 0)
+    if (accessor_ >= 0 && GetBehavior() == DOpEtypes::VectorStorageType::mapped_file)
+      {
+        const VECTOR &vector = *local_vectors_[global_to_local_[accessor_]];
+        if (vector.size() != 0)
+          {
+            assert(mapping_offsets_[accessor_+1] - mapping_offsets_[accessor_]
+                   == vector.size() * sizeof(typename VECTOR::value_type));
+            std::copy(vector.begin(), vector.end(),
+                      reinterpret_cast<typename VECTOR::value_type *>(mapping_ + mapping_offsets_[accessor_]));
+            stvector_information_.at(accessor_).on_disc_ = true;
+          }
+      }
+    else if (accessor_ >= 0 && GetBehavior() == DOpEtypes::VectorStorageType::compressed)
+      {
+        const VECTOR &vector = *local_vectors_[global_to_local_[accessor_]];
+        if (vector.size() != 0)
+          {
+            Timer timer;
+            Compress(vector, compression_tolerance_, compressed_.at(accessor_));
+            timer.stop();
+            compression_time_ += timer.wall_time();
+            stvector_information_.at(accessor_).on_disc_ = true;
+          }
+      }
+    else if (accessor_ >= 0)
       {
         //now if there is something to store, do it
-        if (local_vectors_[global_to_local_[accessor_]]->size() != 0)
+        if (local_vectors_[global_to_local_[accessor_]]->size() != 0
+            && memory_budget_ > 0)
           {
-            MakeName(accessor_);
-            assert(!filestream_.is_open());
-            filestream_.open(filename_.c_str(), std::fstream::out);
-            if (!filestream_.fail())
-              {
-                DOpEHelper::write (*local_vectors_[global_to_local_[accessor_]],
-                                   filestream_);
-                filestream_.close();
-                stvector_information_.at(accessor_).on_disc_ = true;
-              }
-            else
-              {
-                throw DOpEException(
-                  "Could not store " + filename_ + "on disc.",
-                  "SpaceTimeVector<VECTOR>::StoreOnDisc");
-              }
+            CacheStore(accessor_, *local_vectors_[global_to_local_[accessor_]]);
+            stvector_information_.at(accessor_).on_disc_ = true;
+          }
+        else if (local_vectors_[global_to_local_[accessor_]]->size() != 0
+                 && n_async_buffers_ > 0)
+          {
+            AsyncStore(accessor_, *local_vectors_[global_to_local_[accessor_]]);
+            stvector_information_.at(accessor_).on_disc_ = true;
+          }
+        else if (local_vectors_[global_to_local_[accessor_]]->size() != 0)
+          {
+            WriteToDisc(accessor_, *local_vectors_[global_to_local_[accessor_]]);
+            stvector_information_.at(accessor_).on_disc_ = true;
           }
       }
   }
 
+  /******************************************************/
+  template<typename VECTOR>
+  void
+  SpaceTimeVector<VECTOR>::WriteToDisc(unsigned int time_point, const VECTOR &vector) const
+  {
+    MakeName(time_point);
+    assert(!filestream_.is_open());
+    filestream_.open(filename_.c_str(), std::fstream::out);
+    if (!filestream_.fail())
+      {
+        DOpEHelper::write (vector, filestream_);
+        filestream_.close();
+      }
+    else
+      {
+        throw DOpEException(
+          "Could not store " + filename_ + "on disc.",
+          "SpaceTimeVector<VECTOR>::WriteToDisc");
+      }
+  }
+
+  /******************************************************/
+  template<typename VECTOR>
+  void
+  SpaceTimeVector<VECTOR>::CacheStore(unsigned int time_point, const VECTOR &vector) const
+  {
+    //A pending prefetch of this time point is outdated now
+    AsyncDrop(time_point);
+
+    auto old = cache_index_.find(time_point);
+    if (old != cache_index_.end())
+      {
+        cache_bytes_ -= old->second.first->size() * sizeof(typename VECTOR::value_type);
+        total_cache_bytes_ -= old->second.first->size() * sizeof(typename VECTOR::value_type);
+        delete old->second.first;
+        cache_list_.erase(old->second.second);
+        cache_index_.erase(old);
+      }
+    cache_list_.push_front(std::make_pair(this, time_point));
+    cache_index_[time_point] = std::make_pair(new VECTOR(vector), cache_list_.begin());
+    cache_bytes_ += vector.size() * sizeof(typename VECTOR::value_type);
+    total_cache_bytes_ += vector.size() * sizeof(typename VECTOR::value_type);
+
+    //The budget is shared with the other vectors, so the least
+    //recently used time point may belong to another vector.
+    while (total_cache_bytes_ > memory_budget_ && !cache_list_.empty())
+      {
+        cache_list_.back().first->CacheEvict(cache_list_.back().second);
+      }
+  }
+
+  /******************************************************/
+  template<typename VECTOR>
+  void
+  SpaceTimeVector<VECTOR>::CacheEvict(unsigned int time_point) const
+  {
+    auto it = cache_index_.find(time_point);
+    assert(it != cache_index_.end());
+    VECTOR *evicted_vector = it->second.first;
+    if (n_async_buffers_ > 0)
+      AsyncStore(time_point, *evicted_vector);
+    else
+      WriteToDisc(time_point, *evicted_vector);
+    cache_bytes_ -= evicted_vector->size() * sizeof(typename VECTOR::value_type);
+    total_cache_bytes_ -= evicted_vector->size() * sizeof(typename VECTOR::value_type);
+    delete evicted_vector;
+    cache_list_.erase(it->second.second);
+    cache_index_.erase(it);
+  }
+
+  /******************************************************/
+  template<typename VECTOR>
+  bool
+  SpaceTimeVector<VECTOR>::CacheFetch(unsigned int time_point, VECTOR &vector) const
+  {
+    auto it = cache_index_.find(time_point);
+    if (it == cache_index_.end())
+      {
+        cache_misses_++;
+        return false;
+      }
+    cache_hits_++;
+    vector = *(it->second.first);
+    //move the time point to the front of the cache
+    cache_list_.splice(cache_list_.begin(), cache_list_, it->second.second);
+    return true;
+  }
+
+  /******************************************************/
+  template<typename VECTOR>
+  void
+  SpaceTimeVector<VECTOR>::CacheFlush() const
+  {
+    for (auto it = cache_index_.begin(); it != cache_index_.end(); ++it)
+      {
+        if (n_async_buffers_ > 0)
+          AsyncStore(it->first, *(it->second.first));
+        else
+          WriteToDisc(it->first, *(it->second.first));
+      }
+  }
+
+  /******************************************************/
+  template<typename VECTOR>
+  void
+  SpaceTimeVector<VECTOR>::CacheClear() const
+  {
+    for (auto it = cache_index_.begin(); it != cache_index_.end(); ++it)
+      {
+        delete it->second.first;
+        cache_list_.erase(it->second.second);
+      }
+    cache_index_.clear();
+    total_cache_bytes_ -= cache_bytes_;
+    cache_bytes_ = 0;
+  }
+
   /******************************************************/
   template<typename VECTOR>
   void
   SpaceTimeVector<VECTOR>::FetchFromDisc(unsigned int time_point, VECTOR &vector) const
   {
+    if (GetBehavior() == DOpEtypes::VectorStorageType::mapped_file)
+      {
+        const size_t n = (mapping_offsets_[time_point+1] - mapping_offsets_[time_point])
+                         / sizeof(typename VECTOR::value_type);
+        if (vector.size() != n)
+          {
+            throw DOpEException("Size of the vector does not match the stored time point "
+                                + Utilities::int_to_string(time_point),
+                                "SpaceTimeVector<VECTOR>::FetchFromDisc");
+          }
+        const typename VECTOR::value_type *data =
+          reinterpret_cast<const typename VECTOR::value_type *>(mapping_ + mapping_offsets_[time_point]);
+        std::copy(data, data + n, vector.begin());
+        return;
+      }
+    if (GetBehavior() == DOpEtypes::VectorStorageType::compressed)
+      {
+        Timer timer;
+        if (!Decompress(compressed_.at(time_point), vector))
+          {
+            throw DOpEException("Size of the vector does not match the stored time point "
+                                + Utilities::int_to_string(time_point),
+                                "SpaceTimeVector<VECTOR>::FetchFromDisc");
+          }
+        timer.stop();
+        decompression_time_ += timer.wall_time();
+        return;
+      }
+    if (memory_budget_ > 0 && CacheFetch(time_point, vector))
+      {
+        return;
+      }
+    if (n_async_buffers_ > 0 && AsyncFetch(time_point, vector))
+      {
+        return;
+      }
     MakeName(time_point);
     assert(!filestream_.is_open());
     filestream_.open(filename_.c_str(), std::fstream::in);
@@ -1782,6 +2576,223 @@ namespace DOpE
       }
   }
 
+  /******************************************************/
+  template<typename VECTOR>
+  void
+  SpaceTimeVector<VECTOR>::MapFile() const
+  {
+    UnmapFile();
+    const unsigned int n_points = GetSpaceTimeHandler()->GetMaxTimePoint() + 1;
+    mapping_offsets_.resize(n_points + 1);
+    mapping_offsets_[0] = 0;
+    for (unsigned int t = 0; t < n_points; t++)
+      {
+        mapping_offsets_[t+1] = mapping_offsets_[t]
+                                + static_cast<size_t>(GetSpaceTimeHandler()->GetNDoFs(vector_type_, t))
+                                * sizeof(typename VECTOR::value_type);
+      }
+    //Matches the pattern of the files removed in ReInit and the destructor
+    const std::string name = tmp_dir_ + DOpEtypesToString(vector_type_) + "vector."
+                             + Utilities::int_to_string(unique_id_) + ".dope";
+    mapping_fd_ = open(name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (mapping_fd_ < 0)
+      {
+        throw DOpEException("Could not open " + name + ".",
+                            "SpaceTimeVector<VECTOR>::MapFile");
+      }
+    if (mapping_offsets_[n_points] == 0)
+      {
+        return;
+      }
+    if (ftruncate(mapping_fd_, mapping_offsets_[n_points]) != 0)
+      {
+        throw DOpEException("Could not resize " + name + ".",
+                            "SpaceTimeVector<VECTOR>::MapFile");
+      }
+    void *map = mmap(NULL, mapping_offsets_[n_points], PROT_READ | PROT_WRITE,
+                     MAP_SHARED, mapping_fd_, 0);
+    if (map == MAP_FAILED)
+      {
+        throw DOpEException("Could not map " + name + " into memory.",
+                            "SpaceTimeVector<VECTOR>::MapFile");
+      }
+    mapping_ = static_cast<char *>(map);
+  }
+
+  /******************************************************/
+  template<typename VECTOR>
+  void
+  SpaceTimeVector<VECTOR>::UnmapFile() const
+  {
+    if (mapping_ != NULL)
+      {
+        munmap(mapping_, mapping_offsets_.back());
+        mapping_ = NULL;
+      }
+    if (mapping_fd_ >= 0)
+      {
+        close(mapping_fd_);
+        mapping_fd_ = -1;
+      }
+  }
+
+  /******************************************************/
+  template<typename VECTOR>
+  VECTOR *
+  SpaceTimeVector<VECTOR>::AsyncBuffer() const
+  {
+    if (!async_free_.empty())
+      {
+        VECTOR *buffer = async_free_.back();
+        async_free_.pop_back();
+        return buffer;
+      }
+    if (async_slices_.size() < n_async_buffers_)
+      {
+        return new VECTOR;
+      }
+    assert(!async_slices_.empty());
+    //The oldest task is most likely finished already
+    AsyncSlice &oldest = async_slices_.front();
+    oldest.task_.join();
+    VECTOR *buffer = oldest.vector_;
+    async_slices_.pop_front();
+    return buffer;
+  }
+
+  /******************************************************/
+  template<typename VECTOR>
+  void
+  SpaceTimeVector<VECTOR>::AsyncStore(unsigned int time_point, const VECTOR &vector) const
+  {
+    //An old prefetch or write of this time point is outdated now
+    AsyncDrop(time_point);
+
+    VECTOR *buffer = AsyncBuffer();
+    *buffer = vector;
+    const std::string name = FileName(time_point);
+    async_slices_.push_back(AsyncSlice());
+    async_slices_.back().time_point_ = time_point;
+    async_slices_.back().vector_ = buffer;
+    async_slices_.back().task_ = dealii::Threads::new_task([buffer, name]()
+    {
+      std::fstream stream(name.c_str(), std::fstream::out);
+      if (stream.fail())
+        {
+          throw DOpEException("Could not store " + name + "on disc.",
+                              "SpaceTimeVector<VECTOR>::AsyncStore");
+        }
+      DOpEHelper::write (*buffer, stream);
+    });
+  }
+
+  /******************************************************/
+  template<typename VECTOR>
+  void
+  SpaceTimeVector<VECTOR>::AsyncPrefetch(unsigned int time_point) const
+  {
+    if (time_point >= stvector_information_.size() || !FileExists(time_point)
+        || cache_index_.count(time_point) != 0)
+      {
+        return;
+      }
+    for (auto it = async_slices_.begin(); it != async_slices_.end(); ++it)
+      {
+        if (it->time_point_ == time_point)
+          return;
+      }
+    VECTOR *buffer = AsyncBuffer();
+    //block_read needs the right structure of the vector
+    GetSpaceTimeHandler ()->ReinitVector (*buffer, vector_type_, time_point);
+    const std::string name = FileName(time_point);
+    async_slices_.push_back(AsyncSlice());
+    async_slices_.back().time_point_ = time_point;
+    async_slices_.back().vector_ = buffer;
+    async_slices_.back().task_ = dealii::Threads::new_task([buffer, name]()
+    {
+      std::fstream stream(name.c_str(), std::fstream::in);
+      if (stream.fail())
+        {
+          throw DOpEException("Could not fetch " + name + "from disc.",
+                              "SpaceTimeVector<VECTOR>::AsyncPrefetch");
+        }
+      DOpEHelper::read (*buffer, stream);
+    });
+  }
+
+  /******************************************************/
+  template<typename VECTOR>
+  void
+  SpaceTimeVector<VECTOR>::AsyncReadAhead(unsigned int first, unsigned int last) const
+  {
+    if (n_async_buffers_ == 0)
+      {
+        return;
+      }
+    if (last_time_point_ >= 0)
+      {
+        if (static_cast<int>(first) > last_time_point_)
+          {
+            AsyncPrefetch(last + 1);
+          }
+        else if (static_cast<int>(first) < last_time_point_ && first > 0)
+          {
+            AsyncPrefetch(first - 1);
+          }
+      }
+    last_time_point_ = first;
+  }
+
+  /******************************************************/
+  template<typename VECTOR>
+  bool
+  SpaceTimeVector<VECTOR>::AsyncFetch(unsigned int time_point, VECTOR &vector) const
+  {
+    for (auto it = async_slices_.begin(); it != async_slices_.end(); ++it)
+      {
+        if (it->time_point_ == time_point)
+          {
+            it->task_.join();
+            vector = *(it->vector_);
+            async_free_.push_back(it->vector_);
+            async_slices_.erase(it);
+            return true;
+          }
+      }
+    return false;
+  }
+
+  /******************************************************/
+  template<typename VECTOR>
+  void
+  SpaceTimeVector<VECTOR>::AsyncDrop(unsigned int time_point) const
+  {
+    for (auto it = async_slices_.begin(); it != async_slices_.end();)
+      {
+        if (it->time_point_ == time_point)
+          {
+            it->task_.join();
+            async_free_.push_back(it->vector_);
+            it = async_slices_.erase(it);
+          }
+        else
+          ++it;
+      }
+  }
+
+  /******************************************************/
+  template<typename VECTOR>
+  void
+  SpaceTimeVector<VECTOR>::AsyncWaitAll() const
+  {
+    for (auto it = async_slices_.begin(); it != async_slices_.end(); ++it)
+      {
+        it->task_.join();
+        async_free_.push_back(it->vector_);
+      }
+    async_slices_.clear();
+  }
+
   /******************************************************/
   template<typename VECTOR>
   void
@@ -1841,7 +2852,7 @@ namespace DOpE
       }
     else
       {
-        if (GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc)
+        if (IsSerialized())
           {
             //Resize local_vectors_ to the right size.
             //We have to take more care in this case because of the
@@ -1858,6 +2869,7 @@ namespace DOpE
                   }
                 global_to_local_[global_indices[i]] = i;
               }
+            AsyncReadAhead(global_indices[0], global_indices[n_local_dofs-1]);
           }
         else
           throw DOpEException("Unknown Behavior " + DOpEtypesToString(GetBehavior()),
@@ -1873,7 +2885,7 @@ namespace DOpE
   {
     //we need this function only in the store on disc case, because
     //else, we would not have dynamic Speicherverwaltung
-    assert(GetBehavior() == DOpEtypes::VectorStorageType::store_on_disc);
+    assert(IsSerialized());
 
     //just do sth, when local_vectors has not the right size
     if (local_vectors_.size() != size)
@@ -0,0 +1,239 @@
+/**
+*
+* Copyright (C) 2012-2018 by the DOpElib authors
+*
+* This file is part of DOpElib
+*
+* DOpElib is free software: you can redistribute it
+* and/or modify it under the terms of the GNU General Public
+* License as published by the Free Software Foundation, either
+* version 3 of the License, or (at your option) any later
+* version.
+*
+* DOpElib is distributed in the hope that it will be
+* useful, but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* Please refer to the file LICENSE.TXT included in this distribution
+* for further information on this license.
+*
+**/
+
+#ifndef ANDERSON_ACCELERATION_H_
+#define ANDERSON_ACCELERATION_H_
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include <deque>
+#include <string>
+
+#include <include/parameterreader.h>
+#include <include/dopeexception.h>
+
+namespace DOpE
+{
+  /**
+   * This class implements Anderson acceleration (Anderson mixing) of a
+   * fixed-point iteration x_{k+1} = g(x_k), e.g., of a staggered scheme where g
+   * consists of subsequent solves of the coupled subproblems with NewtonSolvers.
+   *
+   * With f_k = g(x_k) - x_k and the differences dF_i = f_{i+1}-f_i,
+   * dG_i = g(x_{i+1}) - g(x_i) of the last `anderson_depth` iterates,
+   * the new iterate is
+   *
+   *   x_{k+1} = g(x_k) - dG gamma - (1-beta)(f_k - dF gamma),
+   *
+   * where gamma minimizes |f_k - dF gamma| and beta is the damping `anderson_damping`.
+   * For `anderson_depth` = 0 this is the (damped) fixed-point iteration.
+   *
+   * @tparam <VECTOR>    The vector type of the fixed-point iteration.
+   */
+  template <typename VECTOR>
+  class AndersonAcceleration
+  {
+  public:
+    AndersonAcceleration(ParameterReader &param_reader);
+
+    static void declare_params(ParameterReader &param_reader);
+
+    /**
+     * Deletes the history, e.g., if the fixed-point map has changed.
+     */
+    void Reset();
+
+    /**
+     * Computes the next iterate from the current one and its image.
+     *
+     * @param x           On input the iterate x_k, on output x_{k+1}.
+     * @param gx          The image g(x_k).
+     */
+    void Update(VECTOR &x, const VECTOR &gx);
+
+    /**
+     * Runs the accelerated fixed-point iteration until |g(x)-x|_infty is less than
+     * max(global_tol, tol |g(x_0)-x_0|_infty).
+     *
+     * @tparam <FIXEDPOINTMAP>  A class with a method
+     *                          `void operator()(const VECTOR &x, VECTOR &gx)`
+     *                          evaluating the fixed-point map.
+     *
+     * @param g           The fixed-point map.
+     * @param x           On input the initial value, on output the fixed point.
+     * @param global_tol  The absolute tolerance.
+     * @param tol         The relative tolerance.
+     * @param maxiter     The maximal number of iterations.
+     *
+     * @return The number of evaluations of g.
+     */
+    template<typename FIXEDPOINTMAP>
+    unsigned int Solve(FIXEDPOINTMAP &g, VECTOR &x, double global_tol, double tol,
+                       unsigned int maxiter);
+
+    /**
+     * Returns the current number of stored differences.
+     */
+    unsigned int GetNHistory() const
+    {
+      return dF_.size();
+    }
+
+  private:
+    unsigned int depth_;
+    double damping_;
+
+    bool has_last_;
+    VECTOR last_f_, last_g_;
+    std::deque<VECTOR> dF_, dG_;
+  };
+
+  /**********************************Implementation*******************************************/
+
+  template <typename VECTOR>
+  void AndersonAcceleration<VECTOR>::declare_params(ParameterReader &param_reader)
+  {
+    param_reader.SetSubsection("anderson parameters");
+    param_reader.declare_entry("anderson_depth", "5",Patterns::Integer(0),"number of previous iterates used for the extrapolation");
+    param_reader.declare_entry("anderson_damping", "1.",Patterns::Double(0,1),"damping of the fixed-point map, 1 means no damping");
+  }
+
+  /*******************************************************************************************/
+
+  template <typename VECTOR>
+  AndersonAcceleration<VECTOR>::AndersonAcceleration(ParameterReader &param_reader)
+  {
+    param_reader.SetSubsection("anderson parameters");
+    depth_   = param_reader.get_integer("anderson_depth");
+    damping_ = param_reader.get_double("anderson_damping");
+    Reset();
+  }
+
+  /*******************************************************************************************/
+
+  template <typename VECTOR>
+  void AndersonAcceleration<VECTOR>::Reset()
+  {
+    has_last_ = false;
+    dF_.clear();
+    dG_.clear();
+  }
+
+  /*******************************************************************************************/
+
+  template <typename VECTOR>
+  void AndersonAcceleration<VECTOR>::Update(VECTOR &x, const VECTOR &gx)
+  {
+    VECTOR f(gx);
+    f -= x;
+
+    if (depth_ > 0 && has_last_)
+      {
+        dF_.push_back(f);
+        dF_.back() -= last_f_;
+        dG_.push_back(gx);
+        dG_.back() -= last_g_;
+        if (dF_.size() > depth_)
+          {
+            dF_.pop_front();
+            dG_.pop_front();
+          }
+      }
+    if (depth_ > 0)
+      {
+        if (!has_last_)
+          {
+            last_f_.reinit(f);
+            last_g_.reinit(gx);
+          }
+        last_f_ = f;
+        last_g_ = gx;
+        has_last_ = true;
+      }
+
+    //x = gx - (1-beta) f
+    x = gx;
+    x.add(damping_-1.,f);
+
+    const unsigned int m = dF_.size();
+    if (m == 0)
+      return;
+
+    //Least squares problem by the normal equations, slightly regularized
+    dealii::FullMatrix<double> M(m,m);
+    dealii::Vector<double> b(m), gamma(m);
+    double trace = 0.;
+    for (unsigned int i = 0; i < m; i++)
+      {
+        for (unsigned int j = 0; j <= i; j++)
+          {
+            M(i,j) = dF_[i]*dF_[j];
+            M(j,i) = M(i,j);
+          }
+        b(i) = dF_[i]*f;
+        trace += M(i,i);
+      }
+    if (trace <= 0.)
+      return;
+    for (unsigned int i = 0; i < m; i++)
+      M(i,i) += 1.e-12*trace;
+    M.gauss_jordan();
+    M.vmult(gamma,b);
+
+    for (unsigned int i = 0; i < m; i++)
+      {
+        x.add(-gamma(i),dG_[i]);
+        x.add((1.-damping_)*gamma(i),dF_[i]);
+      }
+  }
+
+  /*******************************************************************************************/
+
+  template <typename VECTOR>
+  template<typename FIXEDPOINTMAP>
+  unsigned int AndersonAcceleration<VECTOR>::Solve(FIXEDPOINTMAP &g, VECTOR &x, double global_tol,
+                                                   double tol, unsigned int maxiter)
+  {
+    Reset();
+    VECTOR gx(x), f(x);
+    double firstres = -1.;
+    for (unsigned int iter = 0; iter <= maxiter; iter++)
+      {
+        g(x,gx);
+        f = gx;
+        f -= x;
+        double res = f.linfty_norm();
+        if (firstres < 0.)
+          firstres = res;
+        if (res <= global_tol || res <= tol * firstres)
+          {
+            x = gx;
+            return iter+1;
+          }
+        Update(x,gx);
+      }
+    throw DOpEIterationException("Iteration count exceeded bounds!","AndersonAcceleration::Solve");
+  }
+}
+#endif
@@ -40,6 +40,9 @@
 
 #include <vector>
 
+#include <wrapper/preconditioner_wrapper.h>
+#include <templates/preconditionerreusepolicy.h>
+
 namespace DOpE
 {
   /**
@@ -87,10 +90,36 @@ namespace DOpE
      *                              should be build by the linear solver in the first iteration.
      *            The default is false, meaning that if we have no idea we don't
      *            want to build a matrix.
+     * @param relative_tol          The relative reduction of the residual requested by the
+     *                              nonlinear solver, e.g., by an inexact Newton method. If it
+     *                              is zero (default), the tolerances given in the parameter file are used.
+     *
+     */
+    template<typename PROBLEM, typename INTEGRATOR>
+    void Solve(PROBLEM &pde, INTEGRATOR &integr, VECTOR &rhs, VECTOR &solution, bool force_matrix_build=false, double relative_tol=0.);
+
+    /**
+     * Solves the linear PDE in the form Ax_i = b_i for several right hand sides.
+     * The matrix and the preconditioner are build at most once and are then
+     * used for all right hand sides.
+     *
+     * @param rhs                   The right hand sides b_i, see above.
+     * @param solution              The solutions x_i, the vector must have the same length as rhs.
+     *                              The solutions are assumed to be zero!
      *
+     * The remaining arguments are the same as above.
      */
     template<typename PROBLEM, typename INTEGRATOR>
-    void Solve(PROBLEM &pde, INTEGRATOR &integr, VECTOR &rhs, VECTOR &solution, bool force_matrix_build=false);
+    void Solve(PROBLEM &pde, INTEGRATOR &integr, std::vector<VECTOR> &rhs, std::vector<VECTOR> &solution, bool force_matrix_build=false, double relative_tol=0.);
+
+    /**
+     * Returns the policy deciding when the preconditioner is recomputed,
+     * e.g., to query the number of rebuilds.
+     */
+    const PreconditionerReusePolicy &GetPreconditionerReusePolicy() const
+    {
+      return precondition_policy_;
+    }
 
   protected:
 
@@ -98,6 +127,7 @@ namespace DOpE
     SPARSITYPATTERN sparsity_pattern_;
     MATRIX matrix_;
     PRECONDITIONER *precondition_;
+    PreconditionerReusePolicy precondition_policy_;
 
     double linear_global_tol_, linear_tol_;
     int  linear_maxiter_;
@@ -112,12 +142,14 @@ namespace DOpE
     param_reader.declare_entry("linear_global_tol", "1.e-16",Patterns::Double(0),"global tolerance for the cg iteration");
     param_reader.declare_entry("linear_tol", "1.e-12",Patterns::Double(0),"relative tolerance for the cg iteration");
     param_reader.declare_entry("linear_maxiter", "1000",Patterns::Integer(0),"maximal number of cg steps");
+    PreconditionerReusePolicy::declare_params(param_reader);
   }
   /******************************************************/
 
   template <typename PRECONDITIONER,typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
   CGLinearSolverWithMatrix<PRECONDITIONER,SPARSITYPATTERN,MATRIX,VECTOR>
   ::CGLinearSolverWithMatrix(ParameterReader &param_reader)
+    : precondition_policy_(param_reader)
   {
     param_reader.SetSubsection("cglinearsolver_withmatrix parameters");
     linear_global_tol_ = param_reader.get_double ("linear_global_tol");
@@ -147,6 +179,8 @@ namespace DOpE
     if (precondition_ != NULL)
       delete precondition_;
     precondition_ = new PRECONDITIONER;
+    DOpEWrapper::ReInitPreconditioner(*precondition_,pde);
+    precondition_policy_.Reset();
 
   }
 
@@ -157,24 +191,57 @@ namespace DOpE
       INTEGRATOR &integr,
       VECTOR &rhs,
       VECTOR &solution,
-      bool force_matrix_build)
+      bool force_matrix_build,
+      double relative_tol)
   {
     if (force_matrix_build)
       {
         integr.ComputeMatrix (pde,matrix_);
-        precondition_->initialize(matrix_);
+        if (precondition_policy_.RebuildOnMatrixBuild())
+          precondition_->initialize(matrix_);
       }
 
 
-    dealii::SolverControl solver_control (linear_maxiter_, linear_global_tol_,false,false);
+    dealii::ReductionControl solver_control (linear_maxiter_, linear_global_tol_, relative_tol,false,false);
     dealii::SolverCG<VECTOR> cg (solver_control);
-    cg.solve (matrix_, solution, rhs,
-              *precondition_);
+    try
+      {
+        cg.solve (matrix_, solution, rhs,
+                  *precondition_);
+      }
+    catch (dealii::SolverControl::NoConvergence &)
+      {
+        if (!precondition_policy_.IsStale())
+          throw;
+        //The preconditioner of an old matrix is too bad, recompute and repeat
+        precondition_->initialize(matrix_);
+        precondition_policy_.Rebuild();
+        solution = 0.;
+        cg.solve (matrix_, solution, rhs,
+                  *precondition_);
+      }
+    precondition_policy_.ReportIterations(solver_control.last_step());
 
     pde.GetDoFConstraints().distribute(solution);
   }
+
   /******************************************************/
 
+  template <typename PRECONDITIONER,typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  template<typename PROBLEM, typename INTEGRATOR>
+  void CGLinearSolverWithMatrix<PRECONDITIONER,SPARSITYPATTERN,MATRIX,VECTOR>::Solve(PROBLEM &pde,
+      INTEGRATOR &integr,
+      std::vector<VECTOR> &rhs,
+      std::vector<VECTOR> &solution,
+      bool force_matrix_build,
+      double relative_tol)
+  {
+    Assert(rhs.size() == solution.size(), dealii::ExcDimensionMismatch(rhs.size(), solution.size()));
+    for (unsigned int i = 0; i < rhs.size(); i++)
+      {
+        Solve(pde,integr,rhs[i],solution[i],force_matrix_build && (i == 0),relative_tol);
+      }
+  }
 
 
 }
@@ -90,10 +90,25 @@ namespace DOpE
      *                              should be build by the linear solver in the first iteration.
      *            The default is false, meaning that if we have no idea we don't
      *            want to build a matrix.
+     * @param relative_tol          Ignored, the system is solved exactly.
      *
      */
     template<typename PROBLEM, typename INTEGRATOR>
-    void Solve(PROBLEM &pde, INTEGRATOR &integr, VECTOR &rhs, VECTOR &solution, bool force_matrix_build=false);
+    void Solve(PROBLEM &pde, INTEGRATOR &integr, VECTOR &rhs, VECTOR &solution, bool force_matrix_build=false, double relative_tol=0.);
+
+    /**
+     * Solves the linear PDE in the form Ax_i = b_i for several right hand sides.
+     * The matrix is build and factorized at most once, the factorization is
+     * then used for all right hand sides.
+     *
+     * @param rhs                   The right hand sides b_i, see above.
+     * @param solution              The solutions x_i, the vector must have the same length as rhs.
+     *                              The solutions are assumed to be zero!
+     *
+     * The remaining arguments are the same as above.
+     */
+    template<typename PROBLEM, typename INTEGRATOR>
+    void Solve(PROBLEM &pde, INTEGRATOR &integr, std::vector<VECTOR> &rhs, std::vector<VECTOR> &solution, bool force_matrix_build=false, double relative_tol=0.);
 
   protected:
 
@@ -157,7 +172,8 @@ namespace DOpE
       INTEGRATOR &integr,
       VECTOR &rhs,
       VECTOR &solution,
-      bool force_matrix_build)
+      bool force_matrix_build,
+      double /*relative_tol*/)
   {
     if (force_matrix_build)
       {
@@ -183,6 +199,24 @@ namespace DOpE
 
   }
 
+  /******************************************************/
+
+  template <typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  template<typename PROBLEM, typename INTEGRATOR>
+  void DirectLinearSolverWithMatrix<SPARSITYPATTERN,MATRIX,VECTOR>::Solve(PROBLEM &pde,
+      INTEGRATOR &integr,
+      std::vector<VECTOR> &rhs,
+      std::vector<VECTOR> &solution,
+      bool force_matrix_build,
+      double relative_tol)
+  {
+    Assert(rhs.size() == solution.size(), dealii::ExcDimensionMismatch(rhs.size(), solution.size()));
+    for (unsigned int i = 0; i < rhs.size(); i++)
+      {
+        Solve(pde,integr,rhs[i],solution[i],force_matrix_build && (i == 0),relative_tol);
+      }
+  }
+
 
 }
 #endif
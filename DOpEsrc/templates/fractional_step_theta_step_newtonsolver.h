@@ -35,6 +35,7 @@
 #include <iomanip>
 
 #include <include/parameterreader.h>
+#include <templates/newtonforcingterm.h>
 
 
 
@@ -168,14 +169,25 @@ namespace DOpE
     template<typename PROBLEM>
     void NonlinearLastTimeEvals(PROBLEM &pde, const VECTOR &last_time_solution, VECTOR &residual);
 
+    /**
+     * Returns the total number of Newton iterations done in NonlinearSolve,
+     * summed over all three cycles, since the construction of the solver.
+     */
+    unsigned int GetNIterations() const
+    {
+      return n_iterations_;
+    }
+
   protected:
 
     inline INTEGRATOR &GetIntegrator();
 
   private:
     INTEGRATOR &integrator_;
+    NewtonForcingTerm forcing_;
 
     bool build_matrix_ = false;
+    unsigned int n_iterations_ = 0;
 
     double nonlinear_global_tol_, nonlinear_tol_, nonlinear_rho_;
     double linesearch_rho_;
@@ -197,6 +209,7 @@ namespace DOpE
     param_reader.declare_entry("line_maxiter", "4",Patterns::Integer(0),"maximal number of linesearch steps");
     param_reader.declare_entry("linesearch_rho", "0.9",Patterns::Double(0),"reduction rate for the linesearch damping paramete");
 
+    NewtonForcingTerm::declare_params(param_reader);
     LINEARSOLVER::declare_params(param_reader);
   }
 
@@ -205,7 +218,7 @@ namespace DOpE
   template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
   FractionalStepThetaStepNewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
   ::FractionalStepThetaStepNewtonSolver(INTEGRATOR &integrator, ParameterReader &param_reader)
-    : LINEARSOLVER(param_reader), integrator_(integrator)
+    : LINEARSOLVER(param_reader), integrator_(integrator), forcing_(param_reader)
   {
     param_reader.SetSubsection("newtonsolver parameters");
     nonlinear_global_tol_ = param_reader.get_double ("nonlinear_global_tol");
@@ -300,6 +313,7 @@ namespace DOpE
     pde.GetOutputHandler()->Write(out,priority);
 
     int iter=0;
+    forcing_.Reset(std::max(nonlinear_global_tol_, firstres * nonlinear_tol_));
     while (res > nonlinear_global_tol_ && res > firstres * nonlinear_tol_)
       {
         iter++;
@@ -313,7 +327,7 @@ namespace DOpE
 
         pde.GetOutputHandler()->SetIterationNumber(iter,"PDENewton");
 
-        LINEARSOLVER::Solve(pde,GetIntegrator(),residual,du,build_matrix);
+        LINEARSOLVER::Solve(pde,GetIntegrator(),residual,du,build_matrix,forcing_.GetLinearTolerance());
         bool was_build = build_matrix;
 
         //Linesearch
@@ -376,6 +390,7 @@ namespace DOpE
                 {
                   build_matrix=true;
                 }
+              forcing_.Update(res,lastres);
               lastres=res;
 
               out << algo_level
@@ -475,6 +490,7 @@ namespace DOpE
 
 
     pde.GetOutputHandler()->Write(out,priority);
+    forcing_.Reset(std::max(nonlinear_global_tol_, firstres * nonlinear_tol_));
     while (res > nonlinear_global_tol_ && res > firstres * nonlinear_tol_)
       {
         iter++;
@@ -485,7 +501,7 @@ namespace DOpE
           }
 
         pde.GetOutputHandler()->SetIterationNumber(iter,"PDENewton");
-        LINEARSOLVER::Solve(pde,GetIntegrator(),residual,du,build_matrix);
+        LINEARSOLVER::Solve(pde,GetIntegrator(),residual,du,build_matrix,forcing_.GetLinearTolerance());
         bool was_build = build_matrix;
         //Linesearch
         {
@@ -546,6 +562,7 @@ namespace DOpE
                 {
                   build_matrix=true;
                 }
+              forcing_.Update(res,lastres);
               lastres=res;
 
               out<<algo_level<<"Newton step: " <<iter<<"\t Residual (rel.): "
@@ -558,6 +575,7 @@ namespace DOpE
             }//End of Linesearch
         }
       }
+    n_iterations_ += iter;
     GetIntegrator().DeleteDomainData("last_time_solution");
     GetIntegrator().DeleteDomainData("last_newton_solution");
 
@@ -621,6 +639,7 @@ namespace DOpE
 
 
     pde.GetOutputHandler()->Write(out,priority);
+    forcing_.Reset(std::max(nonlinear_global_tol_, firstres * nonlinear_tol_));
     while (res > nonlinear_global_tol_ && res > firstres * nonlinear_tol_)
       {
         iter++;
@@ -631,7 +650,7 @@ namespace DOpE
           }
 
         pde.GetOutputHandler()->SetIterationNumber(iter,"PDENewton");
-        LINEARSOLVER::Solve(pde,GetIntegrator(),residual,du,build_matrix);
+        LINEARSOLVER::Solve(pde,GetIntegrator(),residual,du,build_matrix,forcing_.GetLinearTolerance());
         bool was_build = build_matrix;
         //Linesearch
         {
@@ -691,6 +710,7 @@ namespace DOpE
                 {
                   build_matrix=true;
                 }
+              forcing_.Update(res,lastres);
               lastres=res;
 
               out<<algo_level<<"Newton step: " <<iter<<"\t Residual (rel.): "
@@ -703,6 +723,7 @@ namespace DOpE
             }//End of Linesearch
         }
       }
+    n_iterations_ += iter;
     GetIntegrator().DeleteDomainData("last_time_solution");
     GetIntegrator().DeleteDomainData("last_newton_solution");
 
@@ -765,6 +786,7 @@ namespace DOpE
 
 
     pde.GetOutputHandler()->Write(out,priority);
+    forcing_.Reset(std::max(nonlinear_global_tol_, firstres * nonlinear_tol_));
     while (res > nonlinear_global_tol_ && res > firstres * nonlinear_tol_)
       {
         iter++;
@@ -775,7 +797,7 @@ namespace DOpE
           }
 
         pde.GetOutputHandler()->SetIterationNumber(iter,"PDENewton");
-        LINEARSOLVER::Solve(pde,GetIntegrator(),residual,du,build_matrix);
+        LINEARSOLVER::Solve(pde,GetIntegrator(),residual,du,build_matrix,forcing_.GetLinearTolerance());
         bool was_build = build_matrix;
         //Linesearch
         {
@@ -835,6 +857,7 @@ namespace DOpE
                 {
                   build_matrix=true;
                 }
+              forcing_.Update(res,lastres);
               lastres=res;
 
               out<<algo_level<<"Newton step: " <<iter<<"\t Residual (rel.): "
@@ -847,6 +870,7 @@ namespace DOpE
             }//End of Linesearch
         }
       }
+    n_iterations_ += iter;
     GetIntegrator().DeleteDomainData("last_time_solution");
     GetIntegrator().DeleteDomainData("last_newton_solution");
 
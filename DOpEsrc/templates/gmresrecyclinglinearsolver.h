@@ -0,0 +1,404 @@
+/**
+*
+* Copyright (C) 2012-2018 by the DOpElib authors
+*
+* This file is part of DOpElib
+*
+* DOpElib is free software: you can redistribute it
+* and/or modify it under the terms of the GNU General Public
+* License as published by the Free Software Foundation, either
+* version 3 of the License, or (at your option) any later
+* version.
+*
+* DOpElib is distributed in the hope that it will be
+* useful, but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* Please refer to the file LICENSE.TXT included in this distribution
+* for further information on this license.
+*
+**/
+
+#ifndef GMRES_RECYCLING_LINEAR_SOLVER_H_
+#define GMRES_RECYCLING_LINEAR_SOLVER_H_
+
+#include <deal.II/lac/vector.h>
+#include <deal.II/lac/block_sparsity_pattern.h>
+#include <deal.II/lac/block_sparse_matrix.h>
+#if DEAL_II_VERSION_GTE(8,5,0)
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#else
+#include <deal.II/lac/compressed_simple_sparsity_pattern.h>
+#endif
+#include <deal.II/lac/solver_gmres.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/full_matrix.h>
+
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include <vector>
+#include <deque>
+#include <algorithm>
+
+#include <wrapper/preconditioner_wrapper.h>
+#include <templates/preconditionerreusepolicy.h>
+
+namespace DOpE
+{
+
+  /**
+   * @class GMRESRecyclingLinearSolverWithMatrix
+   *
+   * This class provides a linear solve for the nonlinear solvers of DOpE.
+   * It can be used in place of the GMRESLinearSolverWithMatrix if many similar
+   * systems are solved consecutively, e.g., in the Newton steps of all time steps of an
+   * instationary problem.
+   *
+   * The solver is a GCRO type method: It keeps a subspace U with C = AU, C^TC = I, over
+   * consecutive calls of Solve. The right hand side is first projected onto the complement
+   * of C, and the GMRES method of dealii is applied to the deflated operator (I-CC^T)A.
+   * After each solve, the new search direction is added to the subspace, the oldest direction
+   * is dropped if more than `recycle_vectors` are stored.
+   *
+   * If the matrix is rebuild, C = AU is recomputed with the new matrix and orthonormalized
+   * (`recycle_on_rebuild = recompute`) or the subspace is deleted (`recycle_on_rebuild = discard`).
+   * The subspace is always deleted in ReInit.
+   *
+   * @tparam <PRECONDITIONER>     The preconditioner class to be used with the solver
+   * @tparam <SPARSITYPATTERN>    The sparsity pattern for the matrix
+   * @tparam <MATRIX>             The matrix type that is used for the storage of the system_matrix
+   * @tparam <VECTOR>             The vector type for the solution and righthandside data,
+   *
+   */
+  template <typename PRECONDITIONER, typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  class GMRESRecyclingLinearSolverWithMatrix
+  {
+  public:
+    GMRESRecyclingLinearSolverWithMatrix( ParameterReader &param_reader);
+    ~GMRESRecyclingLinearSolverWithMatrix();
+
+    static void declare_params(ParameterReader &param_reader);
+
+    /**
+       This Function should be called once after grid refinement, or changes in boundary values
+       to  recompute sparsity patterns, and constraint matrices.
+     */
+    template<typename PROBLEM>
+    void ReInit(PROBLEM &pde);
+
+    /**
+     * Solves the linear PDE in the form Ax = b using dealii::SolverGMRES
+     * deflated by the recycled subspace.
+     *
+     *
+     * @tparam <PROBLEM>            The problem that we want to solve, this is passed on to the INTEGRATOR
+     *                              to calculate the matrix.
+     * @tparam <INTEGRATOR>         The integrator used to calculate the matrix A.
+     * @param rhs                   Right Hand Side of the Equation, i.e., the VECTOR b.
+     *                              Note that rhs is not const, this is because we need to apply
+     *                              the boundary values to this vector!
+     * @param solution              The Approximate Solution of the Linear Equation.
+     *                              It is assumed to be zero! Upon completion this VECTOR stores x
+     * @param force_build_matrix    A boolean value, that indicates whether the Matrix
+     *                              should be build by the linear solver in the first iteration.
+     *            The default is false, meaning that if we have no idea we don't
+     *            want to build a matrix.
+     * @param relative_tol          The relative reduction of the residual requested by the
+     *                              nonlinear solver, e.g., by an inexact Newton method. If it
+     *                              is zero (default), the tolerances given in the parameter file are used.
+     *
+     */
+    template<typename PROBLEM, typename INTEGRATOR>
+    void Solve(PROBLEM &pde,INTEGRATOR &integr, VECTOR &rhs, VECTOR &solution, bool force_matrix_build=false, double relative_tol=0.);
+
+    /**
+     * Solves the linear PDE in the form Ax_i = b_i for several right hand sides.
+     * The matrix and the preconditioner are build at most once and are then
+     * used for all right hand sides.
+     * The search directions of the first right hand sides are recycled
+     * for the following ones.
+     *
+     * @param rhs                   The right hand sides b_i, see above.
+     * @param solution              The solutions x_i, the vector must have the same length as rhs.
+     *                              The solutions are assumed to be zero!
+     *
+     * The remaining arguments are the same as above.
+     */
+    template<typename PROBLEM, typename INTEGRATOR>
+    void Solve(PROBLEM &pde, INTEGRATOR &integr, std::vector<VECTOR> &rhs, std::vector<VECTOR> &solution, bool force_matrix_build=false, double relative_tol=0.);
+
+    /**
+     * Returns the policy deciding when the preconditioner is recomputed,
+     * e.g., to query the number of rebuilds.
+     */
+    const PreconditionerReusePolicy &GetPreconditionerReusePolicy() const
+    {
+      return precondition_policy_;
+    }
+
+    /**
+     * Returns the number of vectors in the recycled subspace.
+     */
+    unsigned int GetNRecycleVectors() const
+    {
+      return U_.size();
+    }
+
+  protected:
+
+  private:
+    /**
+     * The operator (I-CC^T)A.
+     */
+    class DeflatedMatrix
+    {
+    public:
+      DeflatedMatrix(const MATRIX &matrix, const std::deque<VECTOR> &C)
+        : matrix_(matrix), C_(C)
+      {
+      }
+
+      void vmult(VECTOR &dst, const VECTOR &src) const
+      {
+        matrix_.vmult(dst,src);
+        for (unsigned int i = 0; i < C_.size(); i++)
+          dst.add(-(C_[i]*dst),C_[i]);
+      }
+
+    private:
+      const MATRIX &matrix_;
+      const std::deque<VECTOR> &C_;
+    };
+
+    /**
+     * Recomputes C = AU after a change of the matrix and orthonormalizes C
+     * by the modified Gram-Schmidt method. The same operations are applied to U.
+     */
+    void UpdateRecycleSpace();
+
+    SPARSITYPATTERN sparsity_pattern_;
+    MATRIX matrix_;
+    PRECONDITIONER *precondition_;
+    PreconditionerReusePolicy precondition_policy_;
+    double linear_global_tol_;
+    int  linear_maxiter_, no_tmp_vectors_, recycle_vectors_;
+    bool recompute_on_rebuild_;
+
+    std::deque<VECTOR> U_, C_;
+  };
+
+  /*********************************Implementation************************************************/
+
+  template <typename PRECONDITIONER,typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  void GMRESRecyclingLinearSolverWithMatrix<PRECONDITIONER,SPARSITYPATTERN,MATRIX,VECTOR>::declare_params(ParameterReader &param_reader)
+  {
+    param_reader.SetSubsection("gmres_recycling parameters");
+    param_reader.declare_entry("linear_global_tol", "1.e-10",Patterns::Double(0),"global tolerance for the gmres iteration");
+    param_reader.declare_entry("linear_maxiter", "1000",Patterns::Integer(0),"maximal number of gmres steps");
+    param_reader.declare_entry("no_tmp_vectors", "100",Patterns::Integer(0),"Number of temporary vectors");
+    param_reader.declare_entry("recycle_vectors", "10",Patterns::Integer(0),"Maximal number of vectors in the recycled subspace");
+    param_reader.declare_entry("recycle_on_rebuild", "recompute",Patterns::Selection("recompute|discard"),"Treatment of the recycled subspace if the matrix is rebuild");
+    PreconditionerReusePolicy::declare_params(param_reader);
+  }
+  /******************************************************/
+
+  template <typename PRECONDITIONER,typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  GMRESRecyclingLinearSolverWithMatrix<PRECONDITIONER,SPARSITYPATTERN,MATRIX,VECTOR>
+  ::GMRESRecyclingLinearSolverWithMatrix(ParameterReader &param_reader)
+    : precondition_policy_(param_reader)
+  {
+    param_reader.SetSubsection("gmres_recycling parameters");
+    linear_global_tol_    = param_reader.get_double ("linear_global_tol");
+    linear_maxiter_       = param_reader.get_integer ("linear_maxiter");
+    no_tmp_vectors_       = param_reader.get_integer ("no_tmp_vectors");
+    recycle_vectors_      = param_reader.get_integer ("recycle_vectors");
+    recompute_on_rebuild_ = (param_reader.get_string ("recycle_on_rebuild") == "recompute");
+    precondition_ = NULL;
+  }
+
+  /******************************************************/
+
+  template <typename PRECONDITIONER,typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  GMRESRecyclingLinearSolverWithMatrix<PRECONDITIONER,SPARSITYPATTERN,MATRIX,VECTOR>::~GMRESRecyclingLinearSolverWithMatrix()
+  {
+    if (precondition_ != NULL)
+      delete precondition_;
+  }
+
+  /******************************************************/
+
+  template <typename PRECONDITIONER,typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  template<typename PROBLEM>
+  void  GMRESRecyclingLinearSolverWithMatrix<PRECONDITIONER,SPARSITYPATTERN,MATRIX,VECTOR>::ReInit(PROBLEM &pde)
+  {
+    matrix_.clear();
+    pde.ComputeSparsityPattern(sparsity_pattern_);
+    matrix_.reinit(sparsity_pattern_);
+    if (precondition_ != NULL)
+      delete precondition_;
+    precondition_ = new PRECONDITIONER;
+    DOpEWrapper::ReInitPreconditioner(*precondition_,pde);
+    precondition_policy_.Reset();
+
+    U_.clear();
+    C_.clear();
+  }
+
+  /******************************************************/
+
+  template <typename PRECONDITIONER,typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  void GMRESRecyclingLinearSolverWithMatrix<PRECONDITIONER,SPARSITYPATTERN,MATRIX,VECTOR>::UpdateRecycleSpace()
+  {
+    std::deque<VECTOR> U, C;
+    for (unsigned int i = 0; i < U_.size(); i++)
+      {
+        VECTOR c;
+        c.reinit(U_[i]);
+        matrix_.vmult(c,U_[i]);
+        for (unsigned int j = 0; j < C.size(); j++)
+          {
+            const double alpha = C[j]*c;
+            c.add(-alpha,C[j]);
+            U_[i].add(-alpha,U[j]);
+          }
+        const double norm = c.l2_norm();
+        //Drop (almost) linear dependent directions
+        if (norm > 1.e-12 * U_[i].l2_norm() && norm > 0.)
+          {
+            c *= 1./norm;
+            U_[i] *= 1./norm;
+            C.push_back(c);
+            U.push_back(U_[i]);
+          }
+      }
+    U_.swap(U);
+    C_.swap(C);
+  }
+
+  /******************************************************/
+
+  template <typename PRECONDITIONER,typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  template<typename PROBLEM, typename INTEGRATOR>
+  void GMRESRecyclingLinearSolverWithMatrix<PRECONDITIONER,SPARSITYPATTERN,MATRIX,VECTOR>::Solve(PROBLEM &pde,
+      INTEGRATOR &integr,
+      VECTOR &rhs,
+      VECTOR &solution,
+      bool force_matrix_build,
+      double relative_tol)
+  {
+    if (force_matrix_build)
+      {
+        integr.ComputeMatrix (pde,matrix_);
+        if (precondition_policy_.RebuildOnMatrixBuild())
+          precondition_->initialize(matrix_);
+        if (recompute_on_rebuild_)
+          UpdateRecycleSpace();
+        else
+          {
+            U_.clear();
+            C_.clear();
+          }
+      }
+
+    //The reduction is measured with respect to the initial residual rhs
+    const double tol = std::max(linear_global_tol_, relative_tol*rhs.l2_norm());
+
+    //Projection onto the recycled subspace: x = UC^Tb, r = (I-CC^T)b
+    VECTOR residual;
+    residual.reinit(rhs);
+    residual = rhs;
+    solution = 0.;
+    for (unsigned int i = 0; i < C_.size(); i++)
+      {
+        const double alpha = C_[i]*residual;
+        solution.add(alpha,U_[i]);
+        residual.add(-alpha,C_[i]);
+      }
+
+    VECTOR z;
+    z.reinit(rhs);
+    if (residual.l2_norm() > tol)
+      {
+        dealii::SolverControl solver_control (linear_maxiter_, tol,false,false);
+
+        // This is gmres specific
+        dealii::GrowingVectorMemory<VECTOR> vector_memory;
+        typename dealii::SolverGMRES<VECTOR>::AdditionalData gmres_data;
+        gmres_data.max_n_tmp_vectors = no_tmp_vectors_;
+        gmres_data.right_preconditioning = true;
+
+        DeflatedMatrix deflated_matrix(matrix_,C_);
+        dealii::SolverGMRES<VECTOR> gmres (solver_control, vector_memory, gmres_data);
+        try
+          {
+            gmres.solve (deflated_matrix, z, residual,
+                         *precondition_);
+          }
+        catch (dealii::SolverControl::NoConvergence &)
+          {
+            if (!precondition_policy_.IsStale())
+              throw;
+            //The preconditioner of an old matrix is too bad, recompute and repeat
+            precondition_->initialize(matrix_);
+            precondition_policy_.Rebuild();
+            z = 0.;
+            gmres.solve (deflated_matrix, z, residual,
+                         *precondition_);
+          }
+        precondition_policy_.ReportIterations(solver_control.last_step());
+
+        //x += z - UC^TAz, the new direction is added to the subspace
+        VECTOR c;
+        c.reinit(rhs);
+        matrix_.vmult(c,z);
+        for (unsigned int i = 0; i < C_.size(); i++)
+          {
+            const double alpha = C_[i]*c;
+            z.add(-alpha,U_[i]);
+            c.add(-alpha,C_[i]);
+          }
+        solution += z;
+
+        const double norm = c.l2_norm();
+        if (recycle_vectors_ > 0 && norm > 0.)
+          {
+            z *= 1./norm;
+            c *= 1./norm;
+            U_.push_back(z);
+            C_.push_back(c);
+            while (U_.size() > static_cast<unsigned int>(recycle_vectors_))
+              {
+                U_.pop_front();
+                C_.pop_front();
+              }
+          }
+      }
+
+    pde.GetDoFConstraints().distribute(solution);
+  }
+
+  /******************************************************/
+
+  template <typename PRECONDITIONER,typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  template<typename PROBLEM, typename INTEGRATOR>
+  void GMRESRecyclingLinearSolverWithMatrix<PRECONDITIONER,SPARSITYPATTERN,MATRIX,VECTOR>::Solve(PROBLEM &pde,
+      INTEGRATOR &integr,
+      std::vector<VECTOR> &rhs,
+      std::vector<VECTOR> &solution,
+      bool force_matrix_build,
+      double relative_tol)
+  {
+    Assert(rhs.size() == solution.size(), dealii::ExcDimensionMismatch(rhs.size(), solution.size()));
+    for (unsigned int i = 0; i < rhs.size(); i++)
+      {
+        Solve(pde,integr,rhs[i],solution[i],force_matrix_build && (i == 0),relative_tol);
+      }
+  }
+
+
+}
+#endif
@@ -0,0 +1,302 @@
+/**
+*
+* Copyright (C) 2012-2018 by the DOpElib authors
+*
+* This file is part of DOpElib
+*
+* DOpElib is free software: you can redistribute it
+* and/or modify it under the terms of the GNU General Public
+* License as published by the Free Software Foundation, either
+* version 3 of the License, or (at your option) any later
+* version.
+*
+* DOpElib is distributed in the hope that it will be
+* useful, but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* Please refer to the file LICENSE.TXT included in this distribution
+* for further information on this license.
+*
+**/
+
+#ifndef INSTAT_STEP_ANDERSON_SOLVER_H_
+#define INSTAT_STEP_ANDERSON_SOLVER_H_
+
+#include <deal.II/lac/vector.h>
+
+#include <iostream>
+#include <iomanip>
+
+#include <include/parameterreader.h>
+#include <include/dopeexception.h>
+#include <templates/instat_step_newtonsolver.h>
+#include <templates/andersonacceleration.h>
+
+namespace DOpE
+{
+  /**
+   * A nonlinear solver class for the time steps of One-Step theta schemes,
+   * which can be used in place of the InstatStepNewtonSolver.
+   *
+   * Instead of Newton's method, the fixed-point iteration
+   *
+   *   g(u) = u + B^{-1}(-A(u)),
+   *
+   * where B is the matrix assembled by the LINEARSOLVER at some previous iterate,
+   * is accelerated by the AndersonAcceleration. The matrix is only rebuild
+   * if the iteration stagnates, i.e., if the residual is reduced by less than
+   * `anderson_rebuild_rho` in an accelerated step, or if it increases with an
+   * old matrix. The history is kept when the matrix is rebuild and only
+   * deleted if a step is rejected. If the linear solver
+   * applies only an approximation of the inverse, e.g., a block triangular
+   * (staggered) solve of a coupled problem, this is an Anderson accelerated
+   * staggered scheme.
+   *
+   * The tolerances and the maximal number of iterations are taken from the
+   * `newtonsolver parameters`, the history depth and the stagnation
+   * criterion from the `anderson parameters`.
+   * As for Newton's method, the iteration starts from the domain data
+   * "initial_guess" if it is given, and GetNIterations counts the
+   * accelerated steps.
+   *
+   * @tparam <INTEGRATOR>          Integration routines to compute domain-, face-, and right-hand side values.
+   * @tparam <LINEARSOLVER>        A linear solver to solve the linear subproblems.
+   * @tparam <VECTOR>              A template class for arbitrary vectors which are given to the
+                                   scheme and where the solution is stored in.
+   */
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  class InstatStepAndersonSolver : public InstatStepNewtonSolver<INTEGRATOR,LINEARSOLVER,VECTOR>
+  {
+  public:
+    InstatStepAndersonSolver(INTEGRATOR &integrator, ParameterReader &param_reader);
+
+    static void declare_params(ParameterReader &param_reader);
+
+    /**
+     * Solves the nonlinear PDE coming from a One-Step theta time-discretization.
+     * For multistage schemes one iteration is done for each stage.
+     * The parameters are the same as in InstatStepNewtonSolver::NonlinearSolve.
+     *
+     * @return a boolean, that indicates whether it should be required to build the matrix next time that
+     *         this method is used, e.g. the value for force_build_matrix of the next call.
+     */
+    template<typename PROBLEM>
+    bool NonlinearSolve(PROBLEM &pde, const VECTOR &last_time_solution, VECTOR &solution,
+                        bool apply_boundary_values=true,
+                        bool force_matrix_build=false, int priority = 5, std::string algo_level = "\t\t ");
+
+  private:
+    /**
+     * The accelerated iteration for one time step, or one stage of a
+     * multistage scheme. The arguments are the same as for NonlinearSolve.
+     */
+    template<typename PROBLEM>
+    bool NonlinearSolveStage(PROBLEM &pde, const VECTOR &last_time_solution, VECTOR &solution,
+                             bool apply_boundary_values,
+                             bool force_matrix_build, int priority, std::string algo_level);
+
+    template<typename PROBLEM>
+    void ComputeResidual(PROBLEM &pde, const VECTOR &time_residual, VECTOR &residual);
+
+    AndersonAcceleration<VECTOR> anderson_;
+
+    double nonlinear_global_tol_, nonlinear_tol_, rebuild_rho_;
+    int nonlinear_maxiter_;
+  };
+
+  /**********************************Implementation*******************************************/
+
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  void InstatStepAndersonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::declare_params(ParameterReader &param_reader)
+  {
+    InstatStepNewtonSolver<INTEGRATOR,LINEARSOLVER,VECTOR>::declare_params(param_reader);
+    AndersonAcceleration<VECTOR>::declare_params(param_reader);
+    param_reader.SetSubsection("anderson parameters");
+    param_reader.declare_entry("anderson_rebuild_rho", "0.9",Patterns::Double(0,1),"minimal reduction of an accelerated step, if actual reduction is less, matrix is rebuild");
+  }
+
+  /*******************************************************************************************/
+
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  InstatStepAndersonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::InstatStepAndersonSolver(INTEGRATOR &integrator, ParameterReader &param_reader)
+    : InstatStepNewtonSolver<INTEGRATOR,LINEARSOLVER,VECTOR>(integrator,param_reader),
+      anderson_(param_reader)
+  {
+    param_reader.SetSubsection("newtonsolver parameters");
+    nonlinear_global_tol_ = param_reader.get_double ("nonlinear_global_tol");
+    nonlinear_tol_        = param_reader.get_double ("nonlinear_tol");
+    nonlinear_maxiter_    = param_reader.get_integer ("nonlinear_maxiter");
+
+    param_reader.SetSubsection("anderson parameters");
+    rebuild_rho_          = param_reader.get_double ("anderson_rebuild_rho");
+  }
+
+  /*******************************************************************************************/
+
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  template<typename PROBLEM>
+  void InstatStepAndersonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::ComputeResidual(PROBLEM &pde, const VECTOR &time_residual, VECTOR &residual)
+  {
+    this->GetIntegrator().ComputeNonlinearLhs(pde,residual);
+    residual -= time_residual;
+    residual *= -1.;
+  }
+
+  /*******************************************************************************************/
+
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  template<typename PROBLEM>
+  bool InstatStepAndersonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::NonlinearSolve(PROBLEM &pde,
+                   const VECTOR &last_time_solution,
+                   VECTOR &solution,
+                   bool apply_boundary_values,
+                   bool force_matrix_build,
+                   int priority,
+                   std::string algo_level)
+  {
+    return this->SolveStages(pde, last_time_solution, solution, force_matrix_build,
+                             [&](VECTOR &stage_solution, bool build_matrix) -> bool
+    {
+      return NonlinearSolveStage(pde, last_time_solution, stage_solution,
+                                 apply_boundary_values, build_matrix,
+                                 priority, algo_level);
+    });
+  }
+
+  /*******************************************************************************************/
+
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  template<typename PROBLEM>
+  bool InstatStepAndersonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::NonlinearSolveStage(PROBLEM &pde,
+                        const VECTOR &last_time_solution,
+                        VECTOR &solution,
+                        bool apply_boundary_values,
+                        bool force_matrix_build,
+                        int priority,
+                        std::string algo_level)
+  {
+    bool build_matrix = force_matrix_build;
+    VECTOR residual, time_residual, tmp_residual;
+    VECTOR du, gu, last_solution;
+    std::stringstream out;
+    pde.GetOutputHandler()->InitNewtonOut(out);
+
+    du.reinit(solution);
+    gu.reinit(solution);
+    last_solution.reinit(solution);
+    residual.reinit(solution);
+    time_residual.reinit(solution);
+    tmp_residual.reinit(solution);
+
+    //Transfer from previous timestep
+    residual = solution;
+    //Start from the initial guess given by the time loop, if any,
+    //otherwise from the last_time_solution.
+    const auto &domain_data = this->GetIntegrator().GetDomainData();
+    auto initial_guess = domain_data.find("initial_guess");
+    if (initial_guess != domain_data.end())
+      solution = *(initial_guess->second);
+    else
+      solution = last_time_solution;
+
+    if (apply_boundary_values)
+      {
+        this->GetIntegrator().ApplyInitialBoundaryValues(pde,solution);
+      }
+
+    // Righthandside for the current timestep f^{n+1}
+    this->GetIntegrator().AddDomainData("last_time_solution",&last_time_solution);
+    this->GetIntegrator().AddDomainData("last_newton_solution",&solution);
+    pde.SetStepPart("New");
+    this->GetIntegrator().ComputeNonlinearRhs(pde,tmp_residual);
+    tmp_residual *= -1;
+    residual += tmp_residual;
+
+    // Save the part of the residual which is independent of  u^{n+1}
+    time_residual = residual;
+    time_residual *=-1;
+
+    ComputeResidual(pde,time_residual,residual);
+
+    pde.GetOutputHandler()->SetIterationNumber(0,"PDENewton");
+    pde.GetOutputHandler()->Write(residual,"Residual"+pde.GetType(),pde.GetDoFType());
+
+    double res = residual.linfty_norm();
+    double firstres = res;
+    double lastres = res;
+    int iter=0;
+    anderson_.Reset();
+
+    out<<algo_level<<"Anderson step: " <<0<<"\t Residual (abs.): "
+       <<pde.GetOutputHandler()->ZeroTolerance(res, 1.0)
+       <<"\n";
+    out<<algo_level<<"Anderson step: " <<0<<"\t Residual (rel.):   "<< std::scientific << pde.GetOutputHandler()->ZeroTolerance(firstres/firstres,1.0);
+    pde.GetOutputHandler()->Write(out,priority);
+
+    while (res > nonlinear_global_tol_ && res > firstres * nonlinear_tol_)
+      {
+        iter++;
+        if (iter > nonlinear_maxiter_)
+          {
+            this->GetIntegrator().DeleteAllData();
+            throw DOpEIterationException("Iteration count exceeded bounds!","InstatStepAndersonSolver::NonlinearSolve");
+          }
+
+        pde.GetOutputHandler()->SetIterationNumber(iter,"PDENewton");
+        bool was_build = build_matrix;
+        LINEARSOLVER::Solve(pde,this->GetIntegrator(),residual,du,build_matrix);
+        build_matrix = false;
+
+        last_solution = solution;
+        gu = solution;
+        gu += du;
+        anderson_.Update(solution,gu);
+
+        ComputeResidual(pde,time_residual,residual);
+        pde.GetOutputHandler()->Write(residual,"Residual"+pde.GetType(),pde.GetDoFType());
+        res = residual.linfty_norm();
+
+        if (res > lastres && !was_build)
+          {
+            // The old matrix is not good enough, rebuild and repeat
+            // without the extrapolation that led to the rejected iterate.
+            build_matrix = true;
+            anderson_.Reset();
+            solution = last_solution;
+            ComputeResidual(pde,time_residual,residual);
+            res = lastres;
+            out<<algo_level<<"Anderson step: "
+               <<iter
+               <<"\t Recalculate with new Matrix";
+            iter--;
+            pde.GetOutputHandler()->Write(out,priority);
+            continue;
+          }
+        if (res/lastres > rebuild_rho_)
+          {
+            build_matrix = true;
+          }
+        lastres = res;
+
+        out<<algo_level<<"Anderson step: " <<iter<<"\t Residual (rel.): "
+           << pde.GetOutputHandler()->ZeroTolerance(res/firstres, 1.0)
+           << "\t History {"<<anderson_.GetNHistory()<<"} ";
+        if (was_build)
+          out<<"M ";
+        pde.GetOutputHandler()->Write(out,priority);
+      }
+    this->GetIntegrator().DeleteDomainData("last_time_solution");
+    this->GetIntegrator().DeleteDomainData("last_newton_solution");
+
+    this->n_iterations_ += iter;
+    return build_matrix;
+  }
+}
+#endif
@@ -35,6 +35,8 @@
 #include <iomanip>
 
 #include <include/parameterreader.h>
+#include <templates/newtonforcingterm.h>
+#include <templates/quasinewtonupdate.h>
 
 
 
@@ -80,13 +82,15 @@ namespace DOpE
 
     /**
      * Solves the nonlinear PDE coming from a One-Step theta time-discretization
-     * described by the PROBLEM using a Newton-Method
+     * described by the PROBLEM using a Newton-Method. For multistage schemes,
+     * i.e., PROBLEM::GetNStages() > 1, one Newton-Method is done for each stage.
      *
      * @tparam <PROBLEM>            The description of the problem we want to solve.
      *
      * @param pde                   The problem
      * @param last_time_solution    A  Vector stores the solution from the previous timestep
-     *                              It is also the starting value of this iteration
+     *                              It is also the starting value of this iteration,
+     *                              unless the integrator holds the domain data "initial_guess".
      * @param solution              A  Vector that will store the solution upon completion
      *                              It is expected that solution is initially set to the return value
      *                              of residual in NonlinearLastTimeEvals!
@@ -149,7 +153,9 @@ namespace DOpE
     /******************************************************/
 
     /**
-     * Evaluates the timestep Problem at the previous time-point, this is part of the rhs for the Solution
+     * Evaluates the timestep Problem at the previous time-point, this is part of the rhs for the Solution.
+     * If the integrator holds the domain data "last_last_time_solution", the step part
+     * `OldOld' of a multistep scheme is evaluated at this vector and added as well.
      *
      * @tparam <PROBLEM>            The description of the problem we want to solve.
      *
@@ -161,14 +167,54 @@ namespace DOpE
     template<typename PROBLEM>
     void NonlinearLastTimeEvals(PROBLEM &pde, const VECTOR &last_time_solution, VECTOR &residual);
 
+    /**
+     * Returns the total number of Newton iterations done in NonlinearSolve
+     * since the construction of the solver. The time loops use the difference
+     * of two calls to report the iterations of one sweep.
+     */
+    unsigned int GetNIterations() const
+    {
+      return n_iterations_;
+    }
+
   protected:
 
     inline INTEGRATOR &GetIntegrator();
 
+    /**
+     * Runs over the stages of a multistage scheme, i.e., if
+     * PROBLEM::GetNStages() > 1. Each stage is solved by
+     * stage_solve(stage_solution, force_matrix_build) after the
+     * contributions of u^n and all earlier stages have been added to
+     * stage_solution; the return value of stage_solve is passed to the
+     * next stage. For one stage schemes stage_solve is called with
+     * solution itself. The arguments are the same as for NonlinearSolve.
+     */
+    template<typename PROBLEM, typename STAGESOLVE>
+    bool SolveStages(PROBLEM &pde, const VECTOR &last_time_solution, VECTOR &solution,
+                     bool force_matrix_build, STAGESOLVE stage_solve);
+
+    //The number of iterations returned by GetNIterations
+    unsigned int n_iterations_ = 0;
+
   private:
+    /**
+     * The Newton method for one time step, or one stage of a multistage
+     * scheme, with the step part `New'. The arguments are the same as
+     * for NonlinearSolve.
+     */
+    template<typename PROBLEM>
+    bool NonlinearSolveStage(PROBLEM &pde, const VECTOR &last_time_solution, VECTOR &solution,
+                             bool apply_boundary_values,
+                             bool force_matrix_build, int priority, std::string algo_level);
+
     INTEGRATOR &integrator_;
+    NewtonForcingTerm forcing_;
+    QuasiNewtonUpdate<VECTOR> quasi_newton_;
 
     bool build_matrix_ = false;
+    //Contributions of u^n to the stages 2,3,... of multistage schemes
+    std::vector<VECTOR> stage_residuals_;
 
     double nonlinear_global_tol_, nonlinear_tol_, nonlinear_rho_;
     double linesearch_rho_;
@@ -190,6 +236,8 @@ namespace DOpE
     param_reader.declare_entry("line_maxiter", "4",Patterns::Integer(0),"maximal number of linesearch steps");
     param_reader.declare_entry("linesearch_rho", "0.9",Patterns::Double(0),"reduction rate for the linesearch damping paramete");
 
+    NewtonForcingTerm::declare_params(param_reader);
+    QuasiNewtonUpdate<VECTOR>::declare_params(param_reader);
     LINEARSOLVER::declare_params(param_reader);
   }
 
@@ -198,7 +246,8 @@ namespace DOpE
   template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
   InstatStepNewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
   ::InstatStepNewtonSolver(INTEGRATOR &integrator, ParameterReader &param_reader)
-    : LINEARSOLVER(param_reader), integrator_(integrator)
+    : LINEARSOLVER(param_reader), integrator_(integrator), forcing_(param_reader),
+      quasi_newton_(param_reader)
   {
     param_reader.SetSubsection("newtonsolver parameters");
     nonlinear_global_tol_ = param_reader.get_double ("nonlinear_global_tol");
@@ -238,6 +287,22 @@ namespace DOpE
     residual =0.;
     GetIntegrator().AddDomainData("last_newton_solution",&last_time_solution);
     GetIntegrator().AddDomainData("last_time_solution",&last_time_solution);
+    //Multistage schemes need the old contributions for each stage,
+    //the ones of the later stages are kept until NonlinearSolve.
+    const unsigned int n_stages = pde.GetNStages();
+    stage_residuals_.resize(n_stages - 1);
+    for (unsigned int s = n_stages; s > 1; s--)
+      {
+        VECTOR &stage_residual = stage_residuals_[s - 2];
+        stage_residual.reinit(residual);
+        pde.SetStage(s);
+        pde.SetStepPart("Old");
+        GetIntegrator().ComputeNonlinearLhs(pde,stage_residual);
+        GetIntegrator().ComputeNonlinearRhs(pde,tmp_residual);
+        tmp_residual *= -1;
+        stage_residual += tmp_residual;
+      }
+    pde.SetStage(1);
     pde.SetStepPart("Old");
     GetIntegrator().ComputeNonlinearLhs(pde,residual);
     GetIntegrator().ComputeNonlinearRhs(pde,tmp_residual);
@@ -247,6 +312,22 @@ namespace DOpE
     GetIntegrator().DeleteDomainData("last_newton_solution");
     GetIntegrator().DeleteDomainData("last_time_solution");
 
+    //Multistep schemes get the solution at the time point before
+    //from the time loop and evaluate it in the step part OldOld.
+    const auto &domain_data = GetIntegrator().GetDomainData();
+    auto last_last = domain_data.find("last_last_time_solution");
+    if (last_last != domain_data.end())
+      {
+        const VECTOR *last_last_time_solution = last_last->second;
+        GetIntegrator().AddDomainData("last_newton_solution",last_last_time_solution);
+        GetIntegrator().AddDomainData("last_time_solution",last_last_time_solution);
+        pde.SetStepPart("OldOld");
+        GetIntegrator().ComputeNonlinearLhs(pde,tmp_residual);
+        residual += tmp_residual;
+
+        GetIntegrator().DeleteDomainData("last_newton_solution");
+        GetIntegrator().DeleteDomainData("last_time_solution");
+      }
   }
   /*******************************************************************************************/
 
@@ -281,6 +362,8 @@ namespace DOpE
     double res = residual.linfty_norm();
     double firstres = res;
     double lastres = res;
+    forcing_.Reset(std::max(nonlinear_global_tol_, firstres * nonlinear_tol_));
+    quasi_newton_.Reset();
 
 
     out<< algo_level << "Newton step: " <<0<<"\t Residual (abs.): "
@@ -306,7 +389,11 @@ namespace DOpE
 
         pde.GetOutputHandler()->SetIterationNumber(iter,"PDENewton");
 
-        LINEARSOLVER::Solve(pde,GetIntegrator(),residual,du,build_matrix);
+        LINEARSOLVER::Solve(pde,GetIntegrator(),residual,du,build_matrix,forcing_.GetLinearTolerance());
+        if (build_matrix)
+          quasi_newton_.Reset();
+        else
+          quasi_newton_.Apply(du);
         bool was_build = build_matrix;
 
         //Linesearch
@@ -365,10 +452,12 @@ namespace DOpE
                   res = residual.linfty_norm();
 
                 }
-              if (res/lastres > nonlinear_rho_)
+              quasi_newton_.StoreStep(du,alpha);
+              if (quasi_newton_.RebuildMatrix(res,lastres,nonlinear_rho_))
                 {
                   build_matrix=true;
                 }
+              forcing_.Update(res,lastres);
               lastres=res;
 
               out << algo_level
@@ -403,6 +492,73 @@ namespace DOpE
                    int priority,
                    std::string algo_level)
   {
+    return SolveStages(pde, last_time_solution, solution, force_matrix_build,
+                       [&](VECTOR &stage_solution, bool build_matrix) -> bool
+    {
+      return NonlinearSolveStage(pde, last_time_solution, stage_solution,
+                                 apply_boundary_values, build_matrix,
+                                 priority, algo_level);
+    });
+  }
+
+  /*******************************************************************************************/
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  template<typename PROBLEM, typename STAGESOLVE>
+  bool InstatStepNewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::SolveStages(PROBLEM &pde,
+                const VECTOR &last_time_solution,
+                VECTOR &solution,
+                bool force_matrix_build,
+                STAGESOLVE stage_solve)
+  {
+    const unsigned int n_stages = pde.GetNStages();
+    if (n_stages == 1)
+      {
+        return stage_solve(solution, force_matrix_build);
+      }
+
+    //Multistage schemes: Each stage is solved with the contributions
+    //of u^n and all earlier stages, the last stage is the solution.
+    bool build_matrix = force_matrix_build;
+    std::vector<VECTOR> stages(n_stages - 1);
+    VECTOR tmp_residual;
+    tmp_residual.reinit(solution);
+    for (unsigned int s = 1; s <= n_stages; s++)
+      {
+        VECTOR stage_residual = (s == 1) ? solution : stage_residuals_[s - 2];
+
+        GetIntegrator().AddDomainData("last_time_solution",&last_time_solution);
+        pde.SetStepPart("OldStage");
+        for (unsigned int j = 1; j < s; j++)
+          {
+            pde.SetStage(s, j);
+            GetIntegrator().AddDomainData("last_newton_solution",&stages[j - 1]);
+            GetIntegrator().ComputeNonlinearLhs(pde,tmp_residual);
+            stage_residual += tmp_residual;
+            GetIntegrator().DeleteDomainData("last_newton_solution");
+          }
+        GetIntegrator().DeleteDomainData("last_time_solution");
+
+        pde.SetStage(s);
+        VECTOR &stage_solution = (s == n_stages) ? solution : stages[s - 1];
+        stage_solution = stage_residual;
+        build_matrix = stage_solve(stage_solution, build_matrix);
+      }
+    return build_matrix;
+  }
+
+  /*******************************************************************************************/
+  template <typename INTEGRATOR, typename LINEARSOLVER,  typename VECTOR>
+  template<typename PROBLEM>
+  bool InstatStepNewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::NonlinearSolveStage(PROBLEM &pde,
+                        const VECTOR &last_time_solution,
+                        VECTOR &solution,
+                        bool apply_boundary_values,
+                        bool force_matrix_build,
+                        int priority,
+                        std::string algo_level)
+  {
 
     bool build_matrix = force_matrix_build;
     VECTOR residual, time_residual, tmp_residual;
@@ -421,8 +577,14 @@ namespace DOpE
 
     //Transfer from previous timestep
     residual =solution;
-    // last_time_solution is very good starting value?
-    solution = last_time_solution;
+    //Start from the initial guess given by the time loop, if any,
+    //otherwise the last_time_solution is a good starting value.
+    const auto &domain_data = GetIntegrator().GetDomainData();
+    auto initial_guess = domain_data.find("initial_guess");
+    if (initial_guess != domain_data.end())
+      solution = *(initial_guess->second);
+    else
+      solution = last_time_solution;
 
     if (apply_boundary_values)
       {
@@ -455,6 +617,8 @@ namespace DOpE
     res = residual.linfty_norm();
     firstres = res;
     lastres = res;
+    forcing_.Reset(std::max(nonlinear_global_tol_, firstres * nonlinear_tol_));
+    quasi_newton_.Reset();
     int iter=0;
 
     out<<algo_level<<"Newton step: " <<0<<"\t Residual (abs.): "
@@ -476,7 +640,11 @@ namespace DOpE
           }
 
         pde.GetOutputHandler()->SetIterationNumber(iter,"PDENewton");
-        LINEARSOLVER::Solve(pde,GetIntegrator(),residual,du,build_matrix);
+        LINEARSOLVER::Solve(pde,GetIntegrator(),residual,du,build_matrix,forcing_.GetLinearTolerance());
+        if (build_matrix)
+          quasi_newton_.Reset();
+        else
+          quasi_newton_.Apply(du);
         bool was_build = build_matrix;
         //Linesearch
         {
@@ -533,10 +701,12 @@ namespace DOpE
                   res = residual.linfty_norm();
 
                 }
-              if (res/lastres > nonlinear_rho_)
+              quasi_newton_.StoreStep(du,alpha);
+              if (quasi_newton_.RebuildMatrix(res,lastres,nonlinear_rho_))
                 {
                   build_matrix=true;
                 }
+              forcing_.Update(res,lastres);
               lastres=res;
 
               out<<algo_level<<"Newton step: " <<iter<<"\t Residual (rel.): "
@@ -549,6 +719,7 @@ namespace DOpE
             }//End of Linesearch
         }
       }
+    n_iterations_ += iter;
     GetIntegrator().DeleteDomainData("last_time_solution");
     GetIntegrator().DeleteDomainData("last_newton_solution");
 
@@ -145,6 +145,11 @@ namespace DOpE
      * For the calculation of the respective quantities, see, e.g.,
      * OptProblemContainer for details on these methods.
      *
+     * If the parameter data contains an entry "pseudo_transient_shift",
+     * its value times the mass matrix of the state finite element is added,
+     * as required by the pseudo-transient continuation of the NewtonSolver.
+     * This needs the update flags update_values and update_JxW_values.
+     *
      * @tparam <PROBLEM>                The problem description
      *
      * @param pde                       The object containing the description of
@@ -1023,6 +1028,12 @@ namespace DOpE
     PROBLEM &pde, MATRIX &matrix)
   {
     matrix = 0.;
+    SCALAR mass_shift = 0.;
+    {
+      auto shift = this->GetParamData().find("pseudo_transient_shift");
+      if (shift != this->GetParamData().end())
+        mass_shift = (*(shift->second))(0);
+    }
     // Begin integration
     unsigned int dofs_per_element;
     std::vector<unsigned int> local_dof_indices;
@@ -1077,6 +1088,28 @@ namespace DOpE
             local_dof_indices.resize(dofs_per_element, 0);
             pde.ElementMatrix(edc, local_matrix);
 
+            if (mass_shift != 0.)
+              {
+                const auto &state_fe_values = edc.GetFEValuesState();
+                const unsigned int n_q_points = edc.GetNQPoints();
+                const unsigned int n_components =
+                  state_fe_values.get_fe().n_components();
+                const unsigned int n_dofs_state =
+                  state_fe_values.get_fe().dofs_per_cell;
+                if (n_dofs_state != dofs_per_element)
+                  throw DOpEException("The pseudo-transient shift needs a matrix on the state finite element!",
+                                      "Integrator::ComputeMatrix");
+                for (unsigned int q_point = 0; q_point < n_q_points; q_point++)
+                  for (unsigned int i = 0; i < n_dofs_state; i++)
+                    for (unsigned int j = 0; j < n_dofs_state; j++)
+                      for (unsigned int comp = 0; comp < n_components; comp++)
+                        local_matrix(i, j) +=
+                          mass_shift *
+                          state_fe_values.shape_value_component(i, q_point, comp) *
+                          state_fe_values.shape_value_component(j, q_point, comp) *
+                          state_fe_values.JxW(q_point);
+              }
+
             if (need_boundary_integrals)
               {
                 for (unsigned int face = 0;
@@ -489,6 +489,12 @@ namespace DOpE
   IntegratorMultiMesh<INTEGRATORDATACONT, VECTOR, SCALAR, dim>::ComputeMatrix(
     PROBLEM &pde, MATRIX &matrix)
   {
+    {
+      auto shift = this->GetParamData().find("pseudo_transient_shift");
+      if (shift != this->GetParamData().end() && (*(shift->second))(0) != 0.)
+        throw DOpEException("Pseudo-transient continuation is not implemented on multiple meshes!",
+                            "IntegratorMultiMesh::ComputeMatrix");
+    }
     matrix = 0.;
 
     const auto &dof_handler =
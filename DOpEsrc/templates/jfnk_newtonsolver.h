@@ -0,0 +1,632 @@
+/**
+*
+* Copyright (C) 2012-2018 by the DOpElib authors
+*
+* This file is part of DOpElib
+*
+* DOpElib is free software: you can redistribute it
+* and/or modify it under the terms of the GNU General Public
+* License as published by the Free Software Foundation, either
+* version 3 of the License, or (at your option) any later
+* version.
+*
+* DOpElib is distributed in the hope that it will be
+* useful, but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* Please refer to the file LICENSE.TXT included in this distribution
+* for further information on this license.
+*
+**/
+
+#ifndef JFNK_NEWTON_SOLVER_H_
+#define JFNK_NEWTON_SOLVER_H_
+
+#include <deal.II/lac/vector.h>
+#include <deal.II/lac/block_sparsity_pattern.h>
+#include <deal.II/lac/block_sparse_matrix.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_gmres.h>
+#include <deal.II/lac/vector_memory.h>
+#include <deal.II/numerics/vector_tools.h>
+#include <deal.II/dofs/dof_tools.h>
+#include <deal.II/fe/component_mask.h>
+#include <set>
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+
+#include <include/dopeexception.h>
+#include <include/parameterreader.h>
+#include <templates/newtonforcingterm.h>
+
+namespace DOpE
+{
+  /**
+   * A Jacobian-free Newton-Krylov (JFNK) solver for nonlinear (stationary) problems.
+   * It can be used in place of the NewtonSolver.
+   *
+   * The Newton update is computed by a right preconditioned GMRES method in which
+   * the action of the Jacobian on a vector v is approximated by the finite difference
+   *
+   *   J(u)v \approx (F(u+hv) - F(u))/h
+   *
+   * of the residual F computed by INTEGRATOR::ComputeNonlinearResidual. Hence, the
+   * matrix is never needed for the Krylov iteration.
+   * The LINEARSOLVER, e.g., DirectLinearSolverWithMatrix, is used as a preconditioner
+   * with the matrix assembled by INTEGRATOR::ComputeMatrix. This matrix is kept
+   * over several Newton steps (and calls of NonlinearSolve) and is only rebuild if
+   * the Newton reduction is less than nonlinear_rho, the GMRES method needs more than
+   * `rebuild_iterations` steps, or fails to converge.
+   *
+   * The relative tolerance of the GMRES method is given by `linear_tol`
+   * or by the forcing term chosen in the newtonsolver parameters, see NewtonForcingTerm.
+   * It is measured, as for the linear solvers with matrix, against the norm of the
+   * nonlinear residual, i.e., the GMRES method stops once
+   * |F(u) + J(u)du| <= tol |F(u)|. Since the preconditioner is applied from the right,
+   * this is the residual computed by the GMRES method itself.
+   *
+   * This solver works on serial vectors only.
+   *
+   * @tparam <INTEGRATOR>          Integration routines to compute domain-, face-, and right-hand side values.
+   * @tparam <LINEARSOLVER>        A linear solver with matrix used as preconditioner.
+   * @tparam <VECTOR>              A template class for arbitrary vectors which are given to the
+                                   solver and where the solution is stored in.
+   */
+
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  class JFNKNewtonSolver : public LINEARSOLVER
+  {
+  public:
+    JFNKNewtonSolver(INTEGRATOR &integrator, ParameterReader &param_reader);
+    ~JFNKNewtonSolver();
+
+    static void declare_params(ParameterReader &param_reader);
+
+    /**
+       This Function should be called once after grid refinement, or changes in boundary values
+       to  recompute sparsity patterns, and constraint matrices.
+     */
+    template<typename PROBLEM>
+    void ReInit(PROBLEM &pde);
+
+    /**
+     * Solves the nonlinear PDE described by the PROBLEM using a Jacobian-free Newton-Krylov method.
+     * The arguments are the same as for NewtonSolver::NonlinearSolve.
+     *
+     * @tparam <PROBLEM>            The description of the problem we want to solve.
+     *
+     * @param pde                   The problem
+     * @param solution              A  Vector that will store the solution upon completion
+     *                              Note that an initial guess for the solution may be stored
+     *                              in this vector as this Vector is used as starting value for the
+     *                              Iteration.
+     * @param apply_boundary_values A boolean that decides whether we apply strong dirichlet boundary values
+     *                              to the Vector solution or not.
+     * @param force_build_matrix    A boolean value, that indicates whether the preconditioning matrix
+     *                              should be build in the first iteration.
+     * @param priority              A number that defines the offset for the priority of the output
+     * @param algo_level            A prefix string to adjust indentation of the output.
+     *
+     * @return a boolean, that indicates whether it should be required to build the matrix next time that
+     *         this method is used, e.g. the value for force_build_matrix of the next call.
+     *
+     */
+    template<typename PROBLEM>
+    bool NonlinearSolve(PROBLEM &pde, VECTOR &solution, bool apply_boundary_values=true,
+                        bool force_matrix_build=false,
+                        int priority = 5, std::string algo_level = "\t\t ");
+
+    /**
+     * Returns the number of assembled matrices since the construction of the solver.
+     */
+    unsigned int GetNMatrixBuilds() const
+    {
+      return n_matrix_builds_;
+    }
+    /**
+     * Returns the number of GMRES steps since the construction of the solver.
+     */
+    unsigned int GetNLinearIterations() const
+    {
+      return n_linear_iterations_;
+    }
+
+  protected:
+
+    inline INTEGRATOR &GetIntegrator();
+
+  private:
+    /**
+     * The finite difference approximation of the Jacobian at the
+     * point u which is registered as `last_newton_solution` in the integrator.
+     */
+    template<typename PROBLEM>
+    class JacobianOperator
+    {
+    public:
+      JacobianOperator(INTEGRATOR &integrator, PROBLEM &pde, VECTOR &u,
+                       const VECTOR &residual, const std::vector<unsigned int> &constrained_dofs,
+                       double difference_step)
+        : integrator_(integrator), pde_(pde), u_(u), residual_(residual),
+          constrained_dofs_(constrained_dofs)
+      {
+        u_backup_ = u;
+        step_scale_ = difference_step*(1.+u.l2_norm());
+        n_evaluations_ = 0;
+      }
+
+      void vmult(VECTOR &dst, const VECTOR &src) const
+      {
+        const double norm = src.l2_norm();
+        if (norm == 0.)
+          {
+            dst = 0.;
+            return;
+          }
+        const double h = step_scale_/norm;
+        u_.add(h,src);
+        integrator_.ComputeNonlinearResidual(pde_,dst);
+        u_ = u_backup_;
+        n_evaluations_++;
+        //residual is -F(u)
+        dst += residual_;
+        dst *= 1./h;
+        for (unsigned int i = 0; i < constrained_dofs_.size(); i++)
+          dst(constrained_dofs_[i]) = src(constrained_dofs_[i]);
+      }
+
+      unsigned int GetNEvaluations() const
+      {
+        return n_evaluations_;
+      }
+
+    private:
+      INTEGRATOR &integrator_;
+      PROBLEM &pde_;
+      VECTOR &u_;
+      VECTOR u_backup_;
+      const VECTOR &residual_;
+      const std::vector<unsigned int> &constrained_dofs_;
+      double step_scale_;
+      mutable unsigned int n_evaluations_;
+    };
+
+    /**
+     * Applies the LINEARSOLVER with the last assembled matrix.
+     */
+    template<typename PROBLEM>
+    class Preconditioner
+    {
+    public:
+      Preconditioner(JFNKNewtonSolver &solver, PROBLEM &pde)
+        : solver_(solver), pde_(pde)
+      {
+      }
+
+      void vmult(VECTOR &dst, const VECTOR &src) const
+      {
+        VECTOR rhs;
+        rhs.reinit(src);
+        rhs = src;
+        dst = 0.;
+        solver_.LINEARSOLVER::Solve(pde_,solver_.GetIntegrator(),rhs,dst,false);
+      }
+
+    private:
+      JFNKNewtonSolver &solver_;
+      PROBLEM &pde_;
+    };
+
+    /**
+     * Collects the DoFs whose rows of the finite difference Jacobian are
+     * replaced by identity rows: all DoFs constrained by the DoFConstraints
+     * of the problem (hanging nodes and user defined constraints) and the
+     * DoFs on the Dirichlet boundary given by the Dirichlet colors and
+     * component masks of the problem.
+     */
+    template<typename PROBLEM>
+    void ComputeConstrainedDoFs(PROBLEM &pde, unsigned int n_dofs,
+                                std::vector<unsigned int> &constrained_dofs) const;
+
+    /**
+     * Solves J(u)du = residual by the preconditioned GMRES method.
+     *
+     * @return the number of GMRES steps.
+     */
+    template<typename PROBLEM>
+    unsigned int LinearSolve(PROBLEM &pde, VECTOR &solution, const VECTOR &residual,
+                             const std::vector<unsigned int> &constrained_dofs,
+                             VECTOR &du, bool &build_matrix);
+
+    INTEGRATOR &integrator_;
+    NewtonForcingTerm forcing_;
+
+    double nonlinear_global_tol_, nonlinear_tol_, nonlinear_rho_;
+    double linesearch_rho_;
+    int nonlinear_maxiter_, line_maxiter_;
+
+    double linear_global_tol_, linear_tol_, difference_step_;
+    int linear_maxiter_, no_tmp_vectors_, rebuild_iterations_;
+
+    unsigned int n_matrix_builds_, n_linear_iterations_;
+  };
+
+  /**********************************Implementation*******************************************/
+
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  void JFNKNewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::declare_params(ParameterReader &param_reader)
+  {
+    param_reader.SetSubsection("newtonsolver parameters");
+    param_reader.declare_entry("nonlinear_global_tol", "1.e-12",Patterns::Double(0),"global tolerance for the newton iteration");
+    param_reader.declare_entry("nonlinear_tol", "1.e-10",Patterns::Double(0),"relative tolerance for the newton iteration");
+    param_reader.declare_entry("nonlinear_maxiter", "10",Patterns::Integer(0),"maximal number of newton iterations");
+    param_reader.declare_entry("nonlinear_rho", "0.1",Patterns::Double(0),"minimal  newton reduction, if actual reduction is less, matrix is rebuild ");
+
+    param_reader.declare_entry("line_maxiter", "4",Patterns::Integer(0),"maximal number of linesearch steps");
+    param_reader.declare_entry("linesearch_rho", "0.9",Patterns::Double(0),"reduction rate for the linesearch damping paramete");
+
+    param_reader.SetSubsection("jfnk parameters");
+    param_reader.declare_entry("linear_global_tol", "1.e-14",Patterns::Double(0),"global tolerance for the gmres iteration");
+    param_reader.declare_entry("linear_tol", "1.e-4",Patterns::Double(0),"relative tolerance for the gmres iteration, if no forcing term is used");
+    param_reader.declare_entry("linear_maxiter", "100",Patterns::Integer(1),"maximal number of gmres steps");
+    param_reader.declare_entry("no_tmp_vectors", "50",Patterns::Integer(1),"Number of temporary vectors");
+    param_reader.declare_entry("difference_step", "1.e-7",Patterns::Double(0),"relative step size of the finite difference approximation of the jacobian");
+    param_reader.declare_entry("rebuild_iterations", "20",Patterns::Integer(0),"number of gmres steps after which the preconditioning matrix is rebuild");
+
+    NewtonForcingTerm::declare_params(param_reader);
+    LINEARSOLVER::declare_params(param_reader);
+  }
+
+  /*******************************************************************************************/
+
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  JFNKNewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::JFNKNewtonSolver(INTEGRATOR &integrator, ParameterReader &param_reader)
+    : LINEARSOLVER(param_reader), integrator_(integrator), forcing_(param_reader)
+  {
+    param_reader.SetSubsection("newtonsolver parameters");
+    nonlinear_global_tol_ = param_reader.get_double ("nonlinear_global_tol");
+    nonlinear_tol_        = param_reader.get_double ("nonlinear_tol");
+    nonlinear_maxiter_    = param_reader.get_integer ("nonlinear_maxiter");
+    nonlinear_rho_        = param_reader.get_double ("nonlinear_rho");
+
+    line_maxiter_   = param_reader.get_integer ("line_maxiter");
+    linesearch_rho_ = param_reader.get_double ("linesearch_rho");
+
+    param_reader.SetSubsection("jfnk parameters");
+    linear_global_tol_  = param_reader.get_double ("linear_global_tol");
+    linear_tol_         = param_reader.get_double ("linear_tol");
+    linear_maxiter_     = param_reader.get_integer ("linear_maxiter");
+    no_tmp_vectors_     = param_reader.get_integer ("no_tmp_vectors");
+    difference_step_    = param_reader.get_double ("difference_step");
+    rebuild_iterations_ = param_reader.get_integer ("rebuild_iterations");
+
+    n_matrix_builds_ = 0;
+    n_linear_iterations_ = 0;
+  }
+
+  /*******************************************************************************************/
+
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  JFNKNewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::~JFNKNewtonSolver()
+  {
+  }
+
+  /*******************************************************************************************/
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  template<typename PROBLEM>
+  void JFNKNewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::ReInit(PROBLEM &pde)
+  {
+    LINEARSOLVER::ReInit(pde);
+  }
+
+  /*******************************************************************************************/
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  template<typename PROBLEM>
+  void JFNKNewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::ComputeConstrainedDoFs(PROBLEM &pde,
+                          unsigned int n_dofs,
+                          std::vector<unsigned int> &constrained_dofs) const
+  {
+    std::vector<bool> constrained(n_dofs,false);
+    for (unsigned int i = 0; i < n_dofs; i++)
+      {
+        if (pde.GetDoFConstraints().is_constrained(i))
+          constrained[i] = true;
+      }
+
+    auto &sth = *(pde.GetBaseProblem().GetSpaceTimeHandler());
+    const auto &dof_handler =
+      sth.GetDoFHandler()[sth.GetStateIndex()]->GetDEALDoFHandler();
+    std::vector<unsigned int> dirichlet_colors = pde.GetDirichletColors();
+    for (unsigned int i = 0; i < dirichlet_colors.size(); i++)
+      {
+        unsigned int color = dirichlet_colors[i];
+        std::set<dealii::types::boundary_id> boundary_indicators;
+        boundary_indicators.insert(color);
+        const dealii::ComponentMask comp_mask(pde.GetDirichletCompMask(color));
+#if DEAL_II_VERSION_GTE(9,4,0)
+        const dealii::IndexSet boundary_dofs =
+          dealii::DoFTools::extract_boundary_dofs(dof_handler, comp_mask, boundary_indicators);
+        for (dealii::types::global_dof_index k : boundary_dofs)
+          constrained[k] = true;
+#else
+        std::vector<bool> boundary_dofs(n_dofs,false);
+        dealii::DoFTools::extract_boundary_dofs(dof_handler, comp_mask, boundary_dofs, boundary_indicators);
+        for (unsigned int k = 0; k < n_dofs; k++)
+          {
+            if (boundary_dofs[k])
+              constrained[k] = true;
+          }
+#endif
+      }
+
+    constrained_dofs.clear();
+    for (unsigned int i = 0; i < n_dofs; i++)
+      {
+        if (constrained[i])
+          constrained_dofs.push_back(i);
+      }
+  }
+
+  /*******************************************************************************************/
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  template<typename PROBLEM>
+  unsigned int JFNKNewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::LinearSolve(PROBLEM &pde,
+                VECTOR &solution,
+                const VECTOR &residual,
+                const std::vector<unsigned int> &constrained_dofs,
+                VECTOR &du,
+                bool &build_matrix)
+  {
+    double relative_tol = forcing_.GetLinearTolerance();
+    if (relative_tol == 0.)
+      relative_tol = linear_tol_;
+    //The identity rows of the constrained DoFs get a zero right hand side,
+    //as the Newton update must not change these values.
+    VECTOR gmres_rhs;
+    gmres_rhs.reinit(residual);
+    gmres_rhs = residual;
+    for (unsigned int i = 0; i < constrained_dofs.size(); i++)
+      gmres_rhs(constrained_dofs[i]) = 0.;
+    //The tolerance refers to the unpreconditioned residual of the
+    //starting value du = 0, not to the one of the preconditioned update below.
+    const double tol = std::max(linear_global_tol_, relative_tol * gmres_rhs.l2_norm());
+
+    VECTOR rhs;
+    rhs.reinit(residual);
+
+    unsigned int n_tries = 0;
+    while (true)
+      {
+        //The update with the assembled matrix is used as starting value
+        //This also builds the preconditioner if required.
+        rhs = residual;
+        du = 0.;
+        LINEARSOLVER::Solve(pde,GetIntegrator(),rhs,du,build_matrix);
+        if (build_matrix)
+          n_matrix_builds_++;
+
+        JacobianOperator<PROBLEM> jacobian(GetIntegrator(),pde,solution,residual,constrained_dofs,difference_step_);
+        Preconditioner<PROBLEM> precondition(*this,pde);
+
+        dealii::SolverControl solver_control (linear_maxiter_, tol, false, false);
+        dealii::GrowingVectorMemory<VECTOR> vector_memory;
+        typename dealii::SolverGMRES<VECTOR>::AdditionalData gmres_data;
+        gmres_data.max_n_tmp_vectors = no_tmp_vectors_;
+        gmres_data.right_preconditioning = true;
+        dealii::SolverGMRES<VECTOR> gmres (solver_control, vector_memory, gmres_data);
+
+        try
+          {
+            gmres.solve (jacobian, du, gmres_rhs, precondition);
+          }
+        catch (dealii::SolverControl::NoConvergence &)
+          {
+            n_linear_iterations_ += solver_control.last_step();
+            n_tries++;
+            if (build_matrix || n_tries > 1)
+              {
+                throw DOpEIterationException("GMRES did not converge with a new preconditioner!","JFNKNewtonSolver::LinearSolve");
+              }
+            //Retry with a new preconditioner
+            build_matrix = true;
+            continue;
+          }
+        n_linear_iterations_ += solver_control.last_step();
+        pde.GetDoFConstraints().distribute(du);
+        return solver_control.last_step();
+      }
+  }
+
+  /*******************************************************************************************/
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  template<typename PROBLEM>
+  bool JFNKNewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::NonlinearSolve(PROBLEM &pde,
+                   VECTOR &solution,
+                   bool apply_boundary_values,
+                   bool force_matrix_build,
+                   int priority,
+                   std::string algo_level)
+  {
+    bool build_matrix = force_matrix_build;
+    VECTOR residual;
+    VECTOR du;
+    std::stringstream out;
+    pde.GetOutputHandler()->InitNewtonOut(out);
+
+    du.reinit(solution);
+    residual.reinit(solution);
+
+    if (apply_boundary_values)
+      {
+        GetIntegrator().ApplyInitialBoundaryValues(pde,solution);
+      }
+
+    GetIntegrator().AddDomainData("last_newton_solution",&solution);
+
+    std::vector<unsigned int> constrained_dofs;
+    ComputeConstrainedDoFs(pde,solution.size(),constrained_dofs);
+
+    GetIntegrator().ComputeNonlinearResidual(pde,residual);
+    residual *= -1.;
+
+    pde.GetOutputHandler()->SetIterationNumber(0,"PDENewton");
+    pde.GetOutputHandler()->Write(residual,"Residual"+pde.GetType(),pde.GetDoFType());
+
+    double res = residual.linfty_norm();
+    double firstres = res;
+    double lastres = res;
+    forcing_.Reset(std::max(nonlinear_global_tol_, firstres * nonlinear_tol_));
+
+
+    out<< algo_level << "Newton step: " <<0<<"\t Residual (abs.): "
+       <<pde.GetOutputHandler()->ZeroTolerance(res, 1.0)
+       <<"\n";
+
+    out<< algo_level << "Newton step: " <<0<<"\t Residual (rel.):   " << std::scientific << firstres/firstres;
+
+
+    pde.GetOutputHandler()->Write(out,priority);
+
+    int iter=0;
+    while (res > nonlinear_global_tol_ && res > firstres * nonlinear_tol_)
+      {
+        iter++;
+
+        if (iter > nonlinear_maxiter_)
+          {
+            GetIntegrator().DeleteDomainData("last_newton_solution");
+            GetIntegrator().DeleteAllData();
+            throw DOpEIterationException("Iteration count exceeded bounds!","JFNKNewtonSolver::NonlinearSolve");
+          }
+
+        pde.GetOutputHandler()->SetIterationNumber(iter,"PDENewton");
+
+        unsigned int linear_steps = 0;
+        try
+          {
+            linear_steps = LinearSolve(pde,solution,residual,constrained_dofs,du,build_matrix);
+          }
+        catch (DOpEIterationException &e)
+          {
+            GetIntegrator().DeleteDomainData("last_newton_solution");
+            GetIntegrator().DeleteAllData();
+            throw e;
+          }
+
+        //Linesearch
+        {
+          solution += du;
+          GetIntegrator().ComputeNonlinearResidual(pde,residual);
+          residual *= -1.;
+
+          pde.GetOutputHandler()->Write(residual,"Residual"+pde.GetType(),pde.GetDoFType());
+          pde.GetOutputHandler()->Write(du,"Update"+pde.GetType(),pde.GetDoFType());
+
+          res = residual.linfty_norm();
+          int lineiter=0;
+          pde.GetOutputHandler()->SetIterationNumber(lineiter,"PDENewtonLS");
+          double rho = linesearch_rho_;
+          double alpha=1;
+          if ( res > lastres && build_matrix == false)
+            {
+              build_matrix = true;
+              // Preconditioner seems to be too bad, rebuild and repeat
+              solution -= du;
+              GetIntegrator().ComputeNonlinearResidual(pde,residual);
+              residual *= -1.;
+              out << algo_level
+                  << "Newton step: "
+                  <<iter
+                  <<"\t Recalculate with new Matrix";
+              iter--;
+              pde.GetOutputHandler()->Write(out,priority);
+            }
+          else
+            {
+              bool was_build = build_matrix;
+              build_matrix = false;
+              pde.GetOutputHandler()->Write(solution,"Intermediate"+pde.GetType(),pde.GetDoFType());
+              while (res > lastres)
+                {
+                  out<< algo_level << "Newton step: " <<iter<<"\t Residual (rel.): "
+                     <<pde.GetOutputHandler()->ZeroTolerance(res/firstres, 1.0)
+                     << "\t LineSearch {"<<lineiter<<"} ";
+                  if (was_build)
+                    out<<"M ";
+                  pde.GetOutputHandler()->Write(out,priority+1);
+
+                  lineiter++;
+                  pde.GetOutputHandler()->SetIterationNumber(lineiter,"PDENewtonLS");
+                  if (lineiter > line_maxiter_)
+                    {
+                      GetIntegrator().DeleteDomainData("last_newton_solution");
+                      GetIntegrator().DeleteAllData();
+                      throw DOpEIterationException("Line-Iteration count exceeded bounds!","JFNKNewtonSolver::NonlinearSolve");
+                    }
+                  solution.add(alpha*(rho-1.),du);
+                  alpha*= rho;
+
+                  GetIntegrator().ComputeNonlinearResidual(pde,residual);
+                  residual *= -1.;
+                  pde.GetOutputHandler()->Write(residual,"Residual"+pde.GetType(),pde.GetDoFType());
+                  pde.GetOutputHandler()->Write(solution,"Intermediate"+pde.GetType(),pde.GetDoFType());
+
+                  res = residual.linfty_norm();
+
+                }
+
+              if (res/lastres > nonlinear_rho_ || linear_steps > static_cast<unsigned int>(rebuild_iterations_))
+                {
+                  build_matrix=true;
+                }
+              forcing_.Update(res,lastres);
+              lastres=res;
+
+              out << algo_level
+                  << "Newton step: "
+                  <<iter
+                  <<"\t Residual (rel.): "
+                  << pde.GetOutputHandler()->ZeroTolerance(res/firstres, 1.0)
+                  << "\t LineSearch {"
+                  <<lineiter
+                  <<"} "
+                  << "\t GMRES {"
+                  << linear_steps
+                  << "} ";
+              if (was_build)
+                out<<"M ";
+
+
+              pde.GetOutputHandler()->Write(out,priority);
+
+            }//End of Linesearch
+        }
+      }
+    GetIntegrator().DeleteDomainData("last_newton_solution");
+
+    return build_matrix;
+  }
+
+  /*******************************************************************************************/
+  template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
+  INTEGRATOR &JFNKNewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
+  ::GetIntegrator()
+  {
+    return integrator_;
+  }
+
+  /*******************************************************************************************/
+
+}
+#endif
@@ -0,0 +1,295 @@
+/**
+*
+* Copyright (C) 2012-2018 by the DOpElib authors
+*
+* This file is part of DOpElib
+*
+* DOpElib is free software: you can redistribute it
+* and/or modify it under the terms of the GNU General Public
+* License as published by the Free Software Foundation, either
+* version 3 of the License, or (at your option) any later
+* version.
+*
+* DOpElib is distributed in the hope that it will be
+* useful, but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* Please refer to the file LICENSE.TXT included in this distribution
+* for further information on this license.
+*
+**/
+
+#ifndef MIXED_PRECISION_DIRECT_LINEAR_SOLVER_H_
+#define MIXED_PRECISION_DIRECT_LINEAR_SOLVER_H_
+
+#include <deal.II/lac/vector.h>
+#include <deal.II/lac/block_vector.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/block_sparsity_pattern.h>
+#include <deal.II/lac/block_sparse_matrix.h>
+#if DEAL_II_VERSION_GTE(8,5,0)
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#else
+#include <deal.II/lac/compressed_simple_sparsity_pattern.h>
+#endif
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_gmres.h>
+#include <deal.II/lac/vector_memory.h>
+#include <deal.II/dofs/dof_tools.h>
+#include <deal.II/numerics/vector_tools.h>
+
+#include <vector>
+#include <algorithm>
+
+#include <include/parameterreader.h>
+#include <templates/sparselufactorization.h>
+
+namespace DOpE
+{
+  /**
+   * @class MixedPrecisionDirectLinearSolverWithMatrix
+   *
+   * This class provides a linear solve for the nonlinear solvers of DOpE,
+   * and can be used in place of the DirectLinearSolverWithMatrix.
+   *
+   * The system matrix is assembled in double precision, but it is factorized
+   * by the SparseLUFactorization in single precision, i.e., the LU factors are stored
+   * as float and need half of the memory of a double precision factorization.
+   * The double precision accuracy is then recovered by iterative refinement, i.e.,
+   * the residual is computed with the double precision matrix and the correction is
+   * obtained from the single precision factors.
+   * If the refinement fails to reduce the residual sufficiently, a GMRES method
+   * preconditioned with the factorization is used instead.
+   *
+   * In contrast to the DirectLinearSolverWithMatrix, UMFPACK is not needed.
+   * The fill of the factors is reduced by an approximate minimum degree
+   * ordering, see SparseLUFactorization.
+   *
+   * @tparam <SPARSITYPATTERN>    The sparsity pattern for the matrix
+   * @tparam <MATRIX>             The matrix type that is used for the storage of the system_matrix,
+   *                              either dealii::SparseMatrix<double> or dealii::BlockSparseMatrix<double>.
+   * @tparam <VECTOR>             The vector type for the solution and righthandside data,
+   *
+   */
+
+  template <typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  class MixedPrecisionDirectLinearSolverWithMatrix
+  {
+  public:
+    MixedPrecisionDirectLinearSolverWithMatrix(ParameterReader &param_reader);
+    ~MixedPrecisionDirectLinearSolverWithMatrix();
+
+    static void declare_params(ParameterReader &param_reader);
+
+    /**
+       This Function should be called once after grid refinement, or changes in boundary values
+       to  recompute sparsity patterns, and constraint matrices.
+     */
+    template<typename PROBLEM>
+    void ReInit(PROBLEM &pde);
+
+    /**
+     * Solves the linear PDE in the form Ax = b using a single precision factorization
+     * of A with iterative refinement.
+     *
+     *
+     * @tparam <PROBLEM>            The problem that we want to solve, this is passed on to the INTEGRATOR
+     *                              to calculate the matrix.
+     * @tparam <INTEGRATOR>         The integrator used to calculate the matrix A.
+     * @param rhs                   Right Hand Side of the Equation, i.e., the VECTOR b.
+     *                              Note that rhs is not const, this is because we need to apply
+     *                              the boundary values to this vector!
+     * @param solution              The Approximate Solution of the Linear Equation.
+     *                              It is assumed to be zero! Upon completion this VECTOR stores x
+     * @param force_build_matrix    A boolean value, that indicates whether the Matrix
+     *                              should be build by the linear solver in the first iteration.
+     *            The default is false, meaning that if we have no idea we don't
+     *            want to build a matrix.
+     * @param relative_tol          If positive, the refinement stops once the residual is reduced
+     *                              by this factor, otherwise refinement_tol is used.
+     *
+     */
+    template<typename PROBLEM, typename INTEGRATOR>
+    void Solve(PROBLEM &pde, INTEGRATOR &integr, VECTOR &rhs, VECTOR &solution, bool force_matrix_build=false, double relative_tol=0.);
+
+    /**
+     * Solves the linear PDE in the form Ax_i = b_i for several right hand sides.
+     * The matrix is build and factorized at most once, the factorization is
+     * then used for all right hand sides.
+     *
+     * @param rhs                   The right hand sides b_i, see above.
+     * @param solution              The solutions x_i, the vector must have the same length as rhs.
+     *                              The solutions are assumed to be zero!
+     *
+     * The remaining arguments are the same as above.
+     */
+    template<typename PROBLEM, typename INTEGRATOR>
+    void Solve(PROBLEM &pde, INTEGRATOR &integr, std::vector<VECTOR> &rhs, std::vector<VECTOR> &solution, bool force_matrix_build=false, double relative_tol=0.);
+
+  protected:
+
+  private:
+    SPARSITYPATTERN sparsity_pattern_;
+    MATRIX matrix_;
+
+    SparseLUFactorization<float> *A_direct_;
+
+    double refinement_tol_, refinement_global_tol_, refinement_rho_, pivot_threshold_;
+    int refinement_maxiter_, linear_maxiter_, no_tmp_vectors_;
+  };
+
+  /*********************************Implementation************************************************/
+
+  template <typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  void MixedPrecisionDirectLinearSolverWithMatrix<SPARSITYPATTERN,MATRIX,VECTOR>::declare_params(ParameterReader &param_reader)
+  {
+    param_reader.SetSubsection("mixed precision direct parameters");
+    param_reader.declare_entry("refinement_tol", "1.e-12",Patterns::Double(0),"relative tolerance for the iterative refinement");
+    param_reader.declare_entry("refinement_global_tol", "1.e-16",Patterns::Double(0),"global tolerance for the iterative refinement");
+    param_reader.declare_entry("refinement_maxiter", "10",Patterns::Integer(0),"maximal number of refinement steps");
+    param_reader.declare_entry("refinement_rho", "0.5",Patterns::Double(0,1),"minimal reduction per refinement step, if the reduction is less gmres is used");
+    param_reader.declare_entry("linear_maxiter", "100",Patterns::Integer(0),"maximal number of gmres steps if the refinement fails");
+    param_reader.declare_entry("no_tmp_vectors", "30",Patterns::Integer(1),"Number of temporary vectors");
+    param_reader.declare_entry("pivot_threshold", "0.1",Patterns::Double(0,1),"the diagonal entry is used as pivot if it is not smaller than pivot_threshold times the largest entry of the column");
+  }
+
+  /******************************************************/
+
+  template <typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  MixedPrecisionDirectLinearSolverWithMatrix<SPARSITYPATTERN,MATRIX,VECTOR>::MixedPrecisionDirectLinearSolverWithMatrix(
+    ParameterReader &param_reader)
+  {
+    param_reader.SetSubsection("mixed precision direct parameters");
+    refinement_tol_        = param_reader.get_double ("refinement_tol");
+    refinement_global_tol_ = param_reader.get_double ("refinement_global_tol");
+    refinement_maxiter_    = param_reader.get_integer ("refinement_maxiter");
+    refinement_rho_        = param_reader.get_double ("refinement_rho");
+    linear_maxiter_        = param_reader.get_integer ("linear_maxiter");
+    no_tmp_vectors_        = param_reader.get_integer ("no_tmp_vectors");
+    pivot_threshold_       = param_reader.get_double ("pivot_threshold");
+
+    A_direct_ = NULL;
+  }
+
+  /******************************************************/
+
+  template <typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  MixedPrecisionDirectLinearSolverWithMatrix<SPARSITYPATTERN,MATRIX,VECTOR>::~MixedPrecisionDirectLinearSolverWithMatrix()
+  {
+    if (A_direct_ != NULL)
+      {
+        delete A_direct_;
+      }
+  }
+
+  /******************************************************/
+
+  template <typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  template<typename PROBLEM>
+  void  MixedPrecisionDirectLinearSolverWithMatrix<SPARSITYPATTERN,MATRIX,VECTOR>::ReInit(PROBLEM &pde)
+  {
+    matrix_.clear();
+    pde.ComputeSparsityPattern(sparsity_pattern_);
+    matrix_.reinit(sparsity_pattern_);
+
+    if (A_direct_ != NULL)
+      {
+        delete A_direct_;
+        A_direct_= NULL;
+      }
+  }
+
+  /******************************************************/
+
+  template <typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  template<typename PROBLEM, typename INTEGRATOR>
+  void MixedPrecisionDirectLinearSolverWithMatrix<SPARSITYPATTERN,MATRIX,VECTOR>::Solve(PROBLEM &pde,
+      INTEGRATOR &integr,
+      VECTOR &rhs,
+      VECTOR &solution,
+      bool force_matrix_build,
+      double relative_tol)
+  {
+    if (force_matrix_build)
+      {
+        integr.ComputeMatrix (pde,matrix_);
+      }
+
+    if (A_direct_ == NULL)
+      {
+        A_direct_ = new SparseLUFactorization<float>(pivot_threshold_);
+        A_direct_->factorize(matrix_);
+      }
+    else if (force_matrix_build)
+      {
+        A_direct_->factorize(matrix_);
+      }
+
+    const double tol = (relative_tol > 0.) ? relative_tol : refinement_tol_;
+    const double rhs_norm = rhs.l2_norm();
+    const double target = std::max(refinement_global_tol_, tol*rhs_norm);
+
+    solution = rhs;
+    A_direct_->solve(solution);
+
+    //Iterative refinement: r = b - Ax in double, Ad = r with the single precision factors
+    VECTOR residual;
+    residual.reinit(rhs);
+    matrix_.vmult(residual,solution);
+    residual.sadd(-1.,1.,rhs);
+    double res = residual.l2_norm();
+    for (int iter = 0; iter < refinement_maxiter_ && res > target; iter++)
+      {
+        A_direct_->solve(residual);
+        solution += residual;
+
+        matrix_.vmult(residual,solution);
+        residual.sadd(-1.,1.,rhs);
+        double newres = residual.l2_norm();
+        bool stagnates = (newres > refinement_rho_ * res);
+        res = newres;
+        if (stagnates)
+          break;
+      }
+
+    if (res > target)
+      {
+        //The refinement stagnates, e.g. for badly conditioned matrices.
+        //Use the factorization as a preconditioner instead.
+        dealii::SolverControl solver_control (linear_maxiter_, target,false,false);
+        dealii::GrowingVectorMemory<VECTOR> vector_memory;
+        typename dealii::SolverGMRES<VECTOR>::AdditionalData gmres_data;
+        gmres_data.max_n_tmp_vectors = no_tmp_vectors_;
+
+        dealii::SolverGMRES<VECTOR> gmres (solver_control, vector_memory, gmres_data);
+        gmres.solve (matrix_, solution, rhs,
+                     *A_direct_);
+      }
+
+    pde.GetDoFConstraints().distribute(solution);
+
+  }
+
+  /******************************************************/
+
+  template <typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  template<typename PROBLEM, typename INTEGRATOR>
+  void MixedPrecisionDirectLinearSolverWithMatrix<SPARSITYPATTERN,MATRIX,VECTOR>::Solve(PROBLEM &pde,
+      INTEGRATOR &integr,
+      std::vector<VECTOR> &rhs,
+      std::vector<VECTOR> &solution,
+      bool force_matrix_build,
+      double relative_tol)
+  {
+    Assert(rhs.size() == solution.size(), dealii::ExcDimensionMismatch(rhs.size(), solution.size()));
+    for (unsigned int i = 0; i < rhs.size(); i++)
+      {
+        Solve(pde,integr,rhs[i],solution[i],force_matrix_build && (i == 0),relative_tol);
+      }
+  }
+
+
+}
+#endif
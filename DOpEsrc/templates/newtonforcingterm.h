@@ -0,0 +1,151 @@
+/**
+*
+* Copyright (C) 2012-2018 by the DOpElib authors
+*
+* This file is part of DOpElib
+*
+* DOpElib is free software: you can redistribute it
+* and/or modify it under the terms of the GNU General Public
+* License as published by the Free Software Foundation, either
+* version 3 of the License, or (at your option) any later
+* version.
+*
+* DOpElib is distributed in the hope that it will be
+* useful, but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* Please refer to the file LICENSE.TXT included in this distribution
+* for further information on this license.
+*
+**/
+
+
+#ifndef NEWTON_FORCING_TERM_H_
+#define NEWTON_FORCING_TERM_H_
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#include <include/parameterreader.h>
+
+namespace DOpE
+{
+  /**
+   * This class computes the relative tolerance (forcing term) for the
+   * linear solves of an inexact Newton method. It is used by the Newton
+   * solvers to avoid the oversolving of the linear systems in the first
+   * Newton steps.
+   *
+   * If `linear_forcing` is set to `fixed` the forcing term is always zero
+   * and the linear solver uses the tolerances given in its own subsection.
+   * If it is `eisenstat_walker`, the forcing term is chosen by
+   * choice 2 of Eisenstat and Walker
+   *
+   *   eta_k = gamma (res_k/res_{k-1})^alpha
+   *
+   * starting with eta_0 = forcing_eta_0 in the first Newton step,
+   * with the safeguards eta_k >= gamma eta_{k-1}^alpha (whenever the right hand side
+   * is larger than 0.1), eta_k <= eta_max and
+   * eta_k >= 0.5 tol/res_k, where tol is the stopping tolerance of the Newton method,
+   * to avoid oversolving in the last step.
+   */
+  class NewtonForcingTerm
+  {
+  public:
+    inline NewtonForcingTerm(ParameterReader &param_reader);
+
+    static inline void declare_params(ParameterReader &param_reader);
+
+    /**
+     * Initializes the forcing term at the beginning of a Newton iteration.
+     *
+     * @param tol         The residual at which the Newton iteration stops.
+     */
+    inline void Reset(double tol);
+
+    /**
+     * Updates the forcing term after a successful Newton step.
+     *
+     * @param res         The nonlinear residual after the step.
+     * @param lastres     The nonlinear residual before the step.
+     */
+    inline void Update(double res, double lastres);
+
+    /**
+     * Returns the relative tolerance for the next linear solve. A value of zero
+     * means that the linear solver should use its default tolerance.
+     */
+    inline double GetLinearTolerance() const;
+
+  private:
+    bool eisenstat_walker_;
+    double eta_, eta_0_, eta_max_, gamma_, alpha_;
+    double tol_;
+  };
+
+  /**********************************Implementation*******************************************/
+
+  void NewtonForcingTerm::declare_params(ParameterReader &param_reader)
+  {
+    param_reader.SetSubsection("newtonsolver parameters");
+    param_reader.declare_entry("linear_forcing", "fixed",Patterns::Selection("fixed|eisenstat_walker"),"choice of the relative tolerance of the linear solves in each newton step");
+    param_reader.declare_entry("forcing_eta_0", "0.5",Patterns::Double(0,1),"relative tolerance of the linear solve in the first newton step for eisenstat_walker");
+    param_reader.declare_entry("forcing_eta_max", "0.9",Patterns::Double(0,1),"maximal relative tolerance of the linear solves for eisenstat_walker");
+    param_reader.declare_entry("forcing_gamma", "0.9",Patterns::Double(0,1),"scaling factor gamma for eisenstat_walker");
+    param_reader.declare_entry("forcing_alpha", "2.",Patterns::Double(1,2),"exponent alpha for eisenstat_walker");
+  }
+
+  /*******************************************************************************************/
+
+  NewtonForcingTerm::NewtonForcingTerm(ParameterReader &param_reader)
+  {
+    param_reader.SetSubsection("newtonsolver parameters");
+    eisenstat_walker_ = (param_reader.get_string("linear_forcing") == "eisenstat_walker");
+    eta_0_            = param_reader.get_double("forcing_eta_0");
+    eta_max_          = param_reader.get_double("forcing_eta_max");
+    gamma_            = param_reader.get_double("forcing_gamma");
+    alpha_            = param_reader.get_double("forcing_alpha");
+    eta_ = std::min(eta_0_, eta_max_);
+    tol_ = 0.;
+  }
+
+  /*******************************************************************************************/
+
+  void NewtonForcingTerm::Reset(double tol)
+  {
+    eta_ = std::min(eta_0_, eta_max_);
+    tol_ = tol;
+  }
+
+  /*******************************************************************************************/
+
+  void NewtonForcingTerm::Update(double res, double lastres)
+  {
+    if (!eisenstat_walker_ || lastres <= 0.)
+      return;
+
+    double eta = gamma_ * std::pow(res/lastres, alpha_);
+    //Safeguard against too fast decrease of eta
+    double eta_safe = gamma_ * std::pow(eta_, alpha_);
+    if (eta_safe > 0.1)
+      eta = std::max(eta, eta_safe);
+    eta = std::min(eta, eta_max_);
+    //Safeguard against oversolving in the final step
+    if (res > 0.)
+      eta = std::max(eta, 0.5*tol_/res);
+    eta_ = std::min(eta, eta_max_);
+  }
+
+  /*******************************************************************************************/
+
+  double NewtonForcingTerm::GetLinearTolerance() const
+  {
+    if (!eisenstat_walker_)
+      return 0.;
+    return eta_;
+  }
+}
+#endif
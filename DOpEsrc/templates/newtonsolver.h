@@ -34,6 +34,8 @@
 #include <iomanip>
 
 #include <include/parameterreader.h>
+#include <templates/newtonforcingterm.h>
+#include <templates/quasinewtonupdate.h>
 
 
 
@@ -43,6 +45,15 @@ namespace DOpE
   /**
    * A nonlinear solver class to compute solutions to nonlinear (stationary) problems
    *
+   * If `pseudo_transient_shift` is positive, the solver uses pseudo-transient continuation,
+   * i.e., the matrix is assembled with the additional term shift*(u,v), where the shift
+   * starts with `pseudo_transient_shift` and is reduced proportional to the residual
+   * (switched evolution relaxation). Once the shift is less than `pseudo_transient_min_shift`
+   * it is set to zero and the iteration becomes Newton's method. The shift is given to
+   * the integrator as parameter data `pseudo_transient_shift`, it is only assembled by the
+   * Integrator class. IntegratorMultiMesh throws an exception if the shift is nonzero,
+   * IntegratorMixedDimensions does not assemble matrices at all.
+   *
    * @tparam <INTEGRATOR>          Integration routines to compute domain-, face-, and right-hand side values.
    * @tparam <LINEARSOLVER>        A linear solver to solve the linear subproblems.
    * @tparam <VECTOR>              A template class for arbitrary vectors which are given to the
@@ -103,11 +114,14 @@ namespace DOpE
 
   private:
     INTEGRATOR &integrator_;
+    NewtonForcingTerm forcing_;
+    QuasiNewtonUpdate<VECTOR> quasi_newton_;
 
     bool build_matrix_;
 
     double nonlinear_global_tol_, nonlinear_tol_, nonlinear_rho_;
     double linesearch_rho_;
+    double pseudo_transient_shift_, pseudo_transient_min_shift_;
     int nonlinear_maxiter_, line_maxiter_;
   };
 
@@ -126,6 +140,11 @@ namespace DOpE
     param_reader.declare_entry("line_maxiter", "4",Patterns::Integer(0),"maximal number of linesearch steps");
     param_reader.declare_entry("linesearch_rho", "0.9",Patterns::Double(0),"reduction rate for the linesearch damping paramete");
 
+    param_reader.declare_entry("pseudo_transient_shift", "0.",Patterns::Double(0),"initial shift of the mass matrix for pseudo-transient continuation, 0 disables it");
+    param_reader.declare_entry("pseudo_transient_min_shift", "1.e-8",Patterns::Double(0),"shift below which pseudo-transient continuation is switched off");
+
+    NewtonForcingTerm::declare_params(param_reader);
+    QuasiNewtonUpdate<VECTOR>::declare_params(param_reader);
     LINEARSOLVER::declare_params(param_reader);
   }
 
@@ -134,7 +153,8 @@ namespace DOpE
   template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
   NewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
   ::NewtonSolver(INTEGRATOR &integrator, ParameterReader &param_reader)
-    : LINEARSOLVER(param_reader), integrator_(integrator)
+    : LINEARSOLVER(param_reader), integrator_(integrator), forcing_(param_reader),
+      quasi_newton_(param_reader)
   {
     param_reader.SetSubsection("newtonsolver parameters");
     nonlinear_global_tol_ = param_reader.get_double ("nonlinear_global_tol");
@@ -145,6 +165,9 @@ namespace DOpE
     line_maxiter_   = param_reader.get_integer ("line_maxiter");
     linesearch_rho_ = param_reader.get_double ("linesearch_rho");
 
+    pseudo_transient_shift_     = param_reader.get_double ("pseudo_transient_shift");
+    pseudo_transient_min_shift_ = param_reader.get_double ("pseudo_transient_min_shift");
+
   }
 
   /*******************************************************************************************/
@@ -191,6 +214,17 @@ namespace DOpE
 
     GetIntegrator().AddDomainData("last_newton_solution",&solution);
 
+    //Shift for pseudo-transient continuation, and the one in the current matrix
+    dealii::Vector<double> ptc_shift(1);
+    double matrix_shift = 0.;
+    bool pseudo_transient = (pseudo_transient_shift_ > 0.);
+    if (pseudo_transient)
+      {
+        ptc_shift(0) = pseudo_transient_shift_;
+        GetIntegrator().AddParamData("pseudo_transient_shift",&ptc_shift);
+        build_matrix = true;
+      }
+
     GetIntegrator().ComputeNonlinearResidual(pde,residual);
     residual *= -1.;
 
@@ -200,6 +234,8 @@ namespace DOpE
     double res = residual.linfty_norm();
     double firstres = res;
     double lastres = res;
+    forcing_.Reset(std::max(nonlinear_global_tol_, firstres * nonlinear_tol_));
+    quasi_newton_.Reset();
 
 
     out<< algo_level << "Newton step: " <<0<<"\t Residual (abs.): "
@@ -225,7 +261,13 @@ namespace DOpE
 
         pde.GetOutputHandler()->SetIterationNumber(iter,"PDENewton");
 
-        LINEARSOLVER::Solve(pde,GetIntegrator(),residual,du,build_matrix);
+        if (pseudo_transient && build_matrix)
+          matrix_shift = ptc_shift(0);
+        LINEARSOLVER::Solve(pde,GetIntegrator(),residual,du,build_matrix,forcing_.GetLinearTolerance());
+        if (build_matrix)
+          quasi_newton_.Reset();
+        else
+          quasi_newton_.Apply(du);
 
         //Linesearch
         {
@@ -289,10 +331,21 @@ namespace DOpE
 
                 }
 
-              if (res/lastres > nonlinear_rho_)
+              quasi_newton_.StoreStep(du,alpha);
+              if (quasi_newton_.RebuildMatrix(res,lastres,nonlinear_rho_))
                 {
                   build_matrix=true;
                 }
+              if (pseudo_transient && ptc_shift(0) > 0.)
+                {
+                  //Switched evolution relaxation
+                  ptc_shift(0) = pseudo_transient_shift_ * res/firstres;
+                  if (ptc_shift(0) < pseudo_transient_min_shift_)
+                    ptc_shift(0) = 0.;
+                  if (ptc_shift(0) < 0.5 * matrix_shift || ptc_shift(0) > 2. * matrix_shift)
+                    build_matrix = true;
+                }
+              forcing_.Update(res,lastres);
               lastres=res;
 
               out << algo_level
@@ -313,6 +366,13 @@ namespace DOpE
         }
       }
     GetIntegrator().DeleteDomainData("last_newton_solution");
+    if (pseudo_transient)
+      {
+        GetIntegrator().DeleteParamData("pseudo_transient_shift");
+        //The matrix still contains the shift
+        if (matrix_shift > 0.)
+          build_matrix = true;
+      }
 
     return build_matrix;
   }
@@ -34,6 +34,7 @@
 #include <iomanip>
 
 #include <include/parameterreader.h>
+#include <templates/newtonforcingterm.h>
 
 
 
@@ -107,6 +108,7 @@ namespace DOpE
 
   private:
     INTEGRATOR &integrator_;
+    NewtonForcingTerm forcing_;
 
     bool build_matrix_ = false;
 
@@ -130,6 +132,7 @@ namespace DOpE
     param_reader.declare_entry("line_maxiter", "4",Patterns::Integer(0),"maximal number of linesearch steps");
     param_reader.declare_entry("linesearch_rho", "0.9",Patterns::Double(0),"reduction rate for the linesearch damping paramete");
 
+    NewtonForcingTerm::declare_params(param_reader);
     LINEARSOLVER::declare_params(param_reader);
   }
 
@@ -138,7 +141,7 @@ namespace DOpE
   template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
   NewtonSolverMixedDimensions<INTEGRATOR,LINEARSOLVER, VECTOR>
   ::NewtonSolverMixedDimensions(INTEGRATOR &integrator, ParameterReader &param_reader)
-    : LINEARSOLVER(param_reader), integrator_(integrator)
+    : LINEARSOLVER(param_reader), integrator_(integrator), forcing_(param_reader)
   {
     param_reader.SetSubsection("newtonsolver parameters");
     nonlinear_global_tol_ = param_reader.get_double ("nonlinear_global_tol");
@@ -216,6 +219,7 @@ namespace DOpE
     pde.GetOutputHandler()->Write(out,priority);
 
     int iter=0;
+    forcing_.Reset(std::max(nonlinear_global_tol_, firstres * nonlinear_tol_));
     while (res > nonlinear_global_tol_ && res > firstres * nonlinear_tol_)
       {
         iter++;
@@ -228,7 +232,7 @@ namespace DOpE
 
         pde.GetOutputHandler()->SetIterationNumber(iter,"PDENewton");
 
-        LINEARSOLVER::Solve(pde,GetIntegrator(),residual,du,build_matrix);
+        LINEARSOLVER::Solve(pde,GetIntegrator(),residual,du,build_matrix,forcing_.GetLinearTolerance());
         bool was_build = build_matrix;
         build_matrix = false;
         //Linesearch
@@ -274,6 +278,7 @@ namespace DOpE
             {
               build_matrix=true;
             }
+          forcing_.Update(res,lastres);
           lastres=res;
 
           out<<algo_level + " Newton step: " <<iter<<"\t Residual (rel.): "
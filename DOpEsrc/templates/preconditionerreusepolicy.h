@@ -0,0 +1,173 @@
+/**
+*
+* Copyright (C) 2012-2018 by the DOpElib authors
+*
+* This file is part of DOpElib
+*
+* DOpElib is free software: you can redistribute it
+* and/or modify it under the terms of the GNU General Public
+* License as published by the Free Software Foundation, either
+* version 3 of the License, or (at your option) any later
+* version.
+*
+* DOpElib is distributed in the hope that it will be
+* useful, but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* Please refer to the file LICENSE.TXT included in this distribution
+* for further information on this license.
+*
+**/
+
+#ifndef PRECONDITIONER_REUSE_POLICY_H_
+#define PRECONDITIONER_REUSE_POLICY_H_
+
+#include <include/parameterreader.h>
+
+namespace DOpE
+{
+  /**
+   * This class decides whether the preconditioner of an iterative linear solver
+   * with matrix (CGLinearSolverWithMatrix, GMRESLinearSolverWithMatrix, ...) has to be
+   * recomputed after the matrix has been rebuild.
+   *
+   * If `precondition_reuse` is false, the preconditioner is recomputed with each
+   * new matrix. Otherwise, the old preconditioner, e.g., an ILU of a previous matrix,
+   * is kept until
+   *  - a linear solve needed more than `precondition_rebuild_iterations` steps,
+   *  - the preconditioner has been kept for `precondition_max_reuse` matrices
+   *    (if this is positive), or
+   *  - the linear solver failed to converge with the old preconditioner.
+   *
+   * The counters GetNRebuilds and GetNReuses can be used to
+   * monitor the policy.
+   */
+  class PreconditionerReusePolicy
+  {
+  public:
+    inline PreconditionerReusePolicy(ParameterReader &param_reader);
+
+    static inline void declare_params(ParameterReader &param_reader);
+
+    /**
+     * Marks the preconditioner as not initialized, e.g., after ReInit.
+     */
+    inline void Reset();
+
+    /**
+     * Called after the matrix has been rebuild.
+     *
+     * @return true if the preconditioner has to be initialized with the new matrix.
+     */
+    inline bool RebuildOnMatrixBuild();
+
+    /**
+     * Called if the preconditioner is initialized for another reason, e.g.,
+     * after the linear solver failed with a stale preconditioner.
+     */
+    inline void Rebuild();
+
+    /**
+     * Reports the number of iterations needed by the last linear solve.
+     */
+    inline void ReportIterations(unsigned int iterations);
+
+    /**
+     * Returns true if the preconditioner has been computed for an older matrix.
+     */
+    bool IsStale() const
+    {
+      return stale_;
+    }
+
+    unsigned int GetNRebuilds() const
+    {
+      return n_rebuilds_;
+    }
+
+    unsigned int GetNReuses() const
+    {
+      return n_reuses_;
+    }
+
+  private:
+    bool reuse_;
+    unsigned int rebuild_iterations_, max_reuse_;
+
+    bool initialized_, rebuild_requested_, stale_;
+    unsigned int n_reuses_since_rebuild_;
+    unsigned int n_rebuilds_, n_reuses_;
+  };
+
+  /**********************************Implementation*******************************************/
+
+  void PreconditionerReusePolicy::declare_params(ParameterReader &param_reader)
+  {
+    param_reader.SetSubsection("preconditioner reuse parameters");
+    param_reader.declare_entry("precondition_reuse", "false",Patterns::Bool(),"keep the preconditioner if the matrix is rebuild");
+    param_reader.declare_entry("precondition_rebuild_iterations", "30",Patterns::Integer(0),"number of linear iterations after which the preconditioner is recomputed with the next matrix");
+    param_reader.declare_entry("precondition_max_reuse", "0",Patterns::Integer(0),"maximal number of matrices the preconditioner is kept for, 0 means unlimited");
+  }
+
+  /*******************************************************************************************/
+
+  PreconditionerReusePolicy::PreconditionerReusePolicy(ParameterReader &param_reader)
+  {
+    param_reader.SetSubsection("preconditioner reuse parameters");
+    reuse_              = param_reader.get_bool("precondition_reuse");
+    rebuild_iterations_ = param_reader.get_integer("precondition_rebuild_iterations");
+    max_reuse_          = param_reader.get_integer("precondition_max_reuse");
+
+    n_rebuilds_ = 0;
+    n_reuses_ = 0;
+    Reset();
+  }
+
+  /*******************************************************************************************/
+
+  void PreconditionerReusePolicy::Reset()
+  {
+    initialized_ = false;
+    rebuild_requested_ = false;
+    stale_ = false;
+    n_reuses_since_rebuild_ = 0;
+  }
+
+  /*******************************************************************************************/
+
+  bool PreconditionerReusePolicy::RebuildOnMatrixBuild()
+  {
+    if (!reuse_ || !initialized_ || rebuild_requested_
+        || (max_reuse_ > 0 && n_reuses_since_rebuild_ >= max_reuse_))
+      {
+        Rebuild();
+        return true;
+      }
+    n_reuses_++;
+    n_reuses_since_rebuild_++;
+    stale_ = true;
+    return false;
+  }
+
+  /*******************************************************************************************/
+
+  void PreconditionerReusePolicy::Rebuild()
+  {
+    n_rebuilds_++;
+    initialized_ = true;
+    rebuild_requested_ = false;
+    stale_ = false;
+    n_reuses_since_rebuild_ = 0;
+  }
+
+  /*******************************************************************************************/
+
+  void PreconditionerReusePolicy::ReportIterations(unsigned int iterations)
+  {
+    if (iterations > rebuild_iterations_)
+      rebuild_requested_ = true;
+  }
+}
+#endif
@@ -87,10 +87,27 @@ namespace DOpE
      *                              should be build by the linear solver in the first iteration.
      *            The default is false, meaning that if we have no idea we don't
      *            want to build a matrix.
+     * @param relative_tol          The relative reduction of the residual requested by the
+     *                              nonlinear solver, e.g., by an inexact Newton method. If it
+     *                              is zero (default), the tolerances given in the parameter file are used.
      *
      */
     template<typename PROBLEM, typename INTEGRATOR>
-    void Solve(PROBLEM &pde, INTEGRATOR &integr, VECTOR &rhs, VECTOR &solution, bool force_matrix_build=false);
+    void Solve(PROBLEM &pde, INTEGRATOR &integr, VECTOR &rhs, VECTOR &solution, bool force_matrix_build=false, double relative_tol=0.);
+
+    /**
+     * Solves the linear PDE in the form Ax_i = b_i for several right hand sides.
+     * The matrix and the preconditioner are build at most once and are then
+     * used for all right hand sides.
+     *
+     * @param rhs                   The right hand sides b_i, see above.
+     * @param solution              The solutions x_i, the vector must have the same length as rhs.
+     *                              The solutions are assumed to be zero!
+     *
+     * The remaining arguments are the same as above.
+     */
+    template<typename PROBLEM, typename INTEGRATOR>
+    void Solve(PROBLEM &pde, INTEGRATOR &integr, std::vector<VECTOR> &rhs, std::vector<VECTOR> &solution, bool force_matrix_build=false, double relative_tol=0.);
 
   protected:
 
@@ -150,7 +167,8 @@ namespace DOpE
       INTEGRATOR &integr,
       VECTOR &rhs,
       VECTOR &solution,
-      bool force_matrix_build)
+      bool force_matrix_build,
+      double relative_tol)
   {
     if (force_matrix_build)
       {
@@ -158,7 +176,7 @@ namespace DOpE
       }
 
 
-    dealii::SolverControl solver_control (linear_maxiter_, linear_global_tol_,false,true);//letzte Arg = false!
+    dealii::ReductionControl solver_control (linear_maxiter_, linear_global_tol_, relative_tol,false,true);//letzte Arg = false!
     dealii::SolverQMRS<VECTOR> qmres (solver_control);
     PRECONDITIONER precondition;
     precondition.initialize(matrix_);
@@ -170,8 +188,24 @@ namespace DOpE
     std::cout<<"XXX"<<tmp.linfty_norm()<<" ---- "<<tmp.l2_norm()<<std::endl;
     pde.GetDoFConstraints().distribute(solution);
   }
+
   /******************************************************/
 
+  template <typename PRECONDITIONER,typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  template<typename PROBLEM, typename INTEGRATOR>
+  void QMRSLinearSolverWithMatrix<PRECONDITIONER,SPARSITYPATTERN,MATRIX,VECTOR>::Solve(PROBLEM &pde,
+      INTEGRATOR &integr,
+      std::vector<VECTOR> &rhs,
+      std::vector<VECTOR> &solution,
+      bool force_matrix_build,
+      double relative_tol)
+  {
+    Assert(rhs.size() == solution.size(), dealii::ExcDimensionMismatch(rhs.size(), solution.size()));
+    for (unsigned int i = 0; i < rhs.size(); i++)
+      {
+        Solve(pde,integr,rhs[i],solution[i],force_matrix_build && (i == 0),relative_tol);
+      }
+  }
 
 
 }
@@ -0,0 +1,229 @@
+/**
+*
+* Copyright (C) 2012-2018 by the DOpElib authors
+*
+* This file is part of DOpElib
+*
+* DOpElib is free software: you can redistribute it
+* and/or modify it under the terms of the GNU General Public
+* License as published by the Free Software Foundation, either
+* version 3 of the License, or (at your option) any later
+* version.
+*
+* DOpElib is distributed in the hope that it will be
+* useful, but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* Please refer to the file LICENSE.TXT included in this distribution
+* for further information on this license.
+*
+**/
+
+#ifndef QUASI_NEWTON_UPDATE_H_
+#define QUASI_NEWTON_UPDATE_H_
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <include/parameterreader.h>
+
+namespace DOpE
+{
+  /**
+   * This class implements the reuse strategies of the matrix (and its
+   * factorization) in the Newton solvers.
+   *
+   * If `quasi_newton` is set to `none`, the matrix is rebuild whenever the
+   * reduction of the residual is worse than `nonlinear_rho`, as in the
+   * standard NewtonSolver.
+   *
+   * If it is `shamanskii`, the matrix is kept for `quasi_newton_max_updates`
+   * steps, or until the reduction is worse than `quasi_newton_rho`.
+   *
+   * If it is `broyden`, the inverse H_0 of the last matrix is additionally corrected
+   * by the rank-one updates of the "good" Broyden method
+   *
+   *   H_{k+1} = H_k + (s_k - H_k y_k) s_k^T H_k / (s_k^T H_k y_k),
+   *
+   * with the step s_k and the change of the residual y_k. The updates are stored
+   * as vectors u_k = (s_k - H_k y_k) / (s_k^T H_k y_k), so that
+   * H_{k+1} z = H_k z + u_k (s_k^T H_k z) can be applied recursively to the
+   * result H_0 z of the linear solver. This costs no additional linear solve.
+   * The matrix is rebuild once `quasi_newton_max_updates` updates are stored,
+   * or if the reduction is worse than `quasi_newton_rho`.
+   *
+   * In all cases, the matrix is also rebuild by the Newton solver if the residual
+   * increases with the old matrix.
+   *
+   * @tparam <VECTOR>    The vector type of the Newton iteration.
+   */
+  template <typename VECTOR>
+  class QuasiNewtonUpdate
+  {
+  public:
+    QuasiNewtonUpdate(ParameterReader &param_reader);
+
+    static void declare_params(ParameterReader &param_reader);
+
+    /**
+     * Deletes all updates, to be called whenever the matrix is rebuild.
+     */
+    void Reset();
+
+    /**
+     * Applies the stored updates.
+     *
+     * @param du          On input, the solution H_0 r of the linear solver
+     *                    for the current residual r, on output H_k r.
+     */
+    void Apply(VECTOR &du);
+
+    /**
+     * Stores the step after a successful line search. The
+     * corresponding update is computed in the next call of Apply.
+     *
+     * @param du          The Newton update computed by Apply.
+     * @param alpha       The damping parameter of the line search, i.e.,
+     *                    the step is alpha du.
+     */
+    void StoreStep(const VECTOR &du, double alpha);
+
+    /**
+     * Decides whether the matrix needs to be rebuild for the next step.
+     *
+     * @param res             The residual after the step.
+     * @param lastres         The residual before the step.
+     * @param nonlinear_rho   The minimal reduction of the standard Newton method.
+     */
+    bool RebuildMatrix(double res, double lastres, double nonlinear_rho) const;
+
+    /**
+     * Returns the number of stored Broyden updates.
+     */
+    unsigned int GetNUpdates() const
+    {
+      return u_.size();
+    }
+
+  private:
+    enum Mode
+    {
+      none,
+      shamanskii,
+      broyden
+    };
+    Mode mode_;
+    double rho_;
+    unsigned int max_updates_;
+
+    unsigned int n_steps_;
+    std::vector<VECTOR> u_, s_;
+    bool pending_;
+    VECTOR pending_du_, pending_s_;
+  };
+
+  /**********************************Implementation*******************************************/
+
+  template <typename VECTOR>
+  void QuasiNewtonUpdate<VECTOR>::declare_params(ParameterReader &param_reader)
+  {
+    param_reader.SetSubsection("newtonsolver parameters");
+    param_reader.declare_entry("quasi_newton", "none",Patterns::Selection("none|shamanskii|broyden"),"reuse strategy of the newton matrix");
+    param_reader.declare_entry("quasi_newton_rho", "0.5",Patterns::Double(0),"minimal newton reduction for shamanskii and broyden, if actual reduction is less, matrix is rebuild");
+    param_reader.declare_entry("quasi_newton_max_updates", "10",Patterns::Integer(1),"maximal number of steps (shamanskii) or updates (broyden) before the matrix is rebuild");
+  }
+
+  /*******************************************************************************************/
+
+  template <typename VECTOR>
+  QuasiNewtonUpdate<VECTOR>::QuasiNewtonUpdate(ParameterReader &param_reader)
+  {
+    param_reader.SetSubsection("newtonsolver parameters");
+    std::string mode = param_reader.get_string("quasi_newton");
+    if (mode == "broyden")
+      mode_ = broyden;
+    else if (mode == "shamanskii")
+      mode_ = shamanskii;
+    else
+      mode_ = none;
+    rho_         = param_reader.get_double("quasi_newton_rho");
+    max_updates_ = param_reader.get_integer("quasi_newton_max_updates");
+    Reset();
+  }
+
+  /*******************************************************************************************/
+
+  template <typename VECTOR>
+  void QuasiNewtonUpdate<VECTOR>::Reset()
+  {
+    n_steps_ = 0;
+    u_.clear();
+    s_.clear();
+    pending_ = false;
+  }
+
+  /*******************************************************************************************/
+
+  template <typename VECTOR>
+  void QuasiNewtonUpdate<VECTOR>::Apply(VECTOR &du)
+  {
+    if (mode_ != broyden)
+      return;
+
+    //H_k r
+    for (unsigned int j = 0; j < u_.size(); j++)
+      du.add(s_[j]*du,u_[j]);
+
+    if (pending_)
+      {
+        //H_k y_k = H_k r_k - H_k r_{k+1}
+        VECTOR hy(pending_du_);
+        hy -= du;
+        const double denom = pending_s_*hy;
+        if (std::fabs(denom) > 1.e-14 * pending_s_.l2_norm() * hy.l2_norm())
+          {
+            VECTOR u(pending_s_);
+            u -= hy;
+            u *= 1./denom;
+            du.add(pending_s_*du,u);
+            u_.push_back(u);
+            s_.push_back(pending_s_);
+          }
+        pending_ = false;
+      }
+  }
+
+  /*******************************************************************************************/
+
+  template <typename VECTOR>
+  void QuasiNewtonUpdate<VECTOR>::StoreStep(const VECTOR &du, double alpha)
+  {
+    n_steps_++;
+    if (mode_ != broyden)
+      return;
+    pending_du_ = du;
+    pending_s_ = du;
+    pending_s_ *= alpha;
+    pending_ = true;
+  }
+
+  /*******************************************************************************************/
+
+  template <typename VECTOR>
+  bool QuasiNewtonUpdate<VECTOR>::RebuildMatrix(double res, double lastres, double nonlinear_rho) const
+  {
+    switch (mode_)
+      {
+      case shamanskii:
+        return (res/lastres > rho_ || n_steps_ >= max_updates_);
+      case broyden:
+        return (res/lastres > rho_ || u_.size() >= max_updates_);
+      default:
+        return (res/lastres > nonlinear_rho);
+      }
+  }
+}
+#endif
@@ -42,6 +42,8 @@
 
 #include <vector>
 
+#include <wrapper/preconditioner_wrapper.h>
+
 namespace DOpE
 {
 
@@ -89,16 +91,34 @@ namespace DOpE
      *                              should be build by the linear solver in the first iteration.
      *            The default is false, meaning that if we have no idea we don't
      *            want to build a matrix.
+     * @param relative_tol          The relative reduction of the residual requested by the
+     *                              nonlinear solver, e.g., by an inexact Newton method. If it
+     *                              is zero (default), the tolerances given in the parameter file are used.
      *
      */
     template<typename PROBLEM, typename INTEGRATOR>
-    void Solve(PROBLEM &pde,INTEGRATOR &integr, VECTOR &rhs, VECTOR &solution, bool force_matrix_build=false);
+    void Solve(PROBLEM &pde,INTEGRATOR &integr, VECTOR &rhs, VECTOR &solution, bool force_matrix_build=false, double relative_tol=0.);
+
+    /**
+     * Solves the linear PDE in the form Ax_i = b_i for several right hand sides.
+     * The matrix and the preconditioner are build at most once and are then
+     * used for all right hand sides.
+     *
+     * @param rhs                   The right hand sides b_i, see above.
+     * @param solution              The solutions x_i, the vector must have the same length as rhs.
+     *                              The solutions are assumed to be zero!
+     *
+     * The remaining arguments are the same as above.
+     */
+    template<typename PROBLEM, typename INTEGRATOR>
+    void Solve(PROBLEM &pde, INTEGRATOR &integr, std::vector<VECTOR> &rhs, std::vector<VECTOR> &solution, bool force_matrix_build=false, double relative_tol=0.);
 
   protected:
 
   private:
     SPARSITYPATTERN sparsity_pattern_;
     MATRIX matrix_;
+    PRECONDITIONER *precondition_;
 
     double linear_global_tol_, linear_tol_ = 0;
     int  linear_maxiter_;
@@ -122,6 +142,7 @@ namespace DOpE
     param_reader.SetSubsection("richardsonwithmatrix parameters");
     linear_global_tol_ = param_reader.get_double ("linear_global_tol");
     linear_maxiter_    = param_reader.get_integer ("linear_maxiter");
+    precondition_ = NULL;
   }
 
   /******************************************************/
@@ -129,6 +150,8 @@ namespace DOpE
   template <typename PRECONDITIONER,typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
   RichardsonLinearSolverWithMatrix<PRECONDITIONER,SPARSITYPATTERN,MATRIX,VECTOR>::~RichardsonLinearSolverWithMatrix()
   {
+    if (precondition_ != NULL)
+      delete precondition_;
   }
 
   /******************************************************/
@@ -140,6 +163,10 @@ namespace DOpE
     matrix_.clear();
     pde.ComputeSparsityPattern(sparsity_pattern_);
     matrix_.reinit(sparsity_pattern_);
+    if (precondition_ != NULL)
+      delete precondition_;
+    precondition_ = new PRECONDITIONER;
+    DOpEWrapper::ReInitPreconditioner(*precondition_,pde);
   }
 
   /******************************************************/
@@ -150,25 +177,43 @@ namespace DOpE
       INTEGRATOR &integr,
       VECTOR &rhs,
       VECTOR &solution,
-      bool force_matrix_build)
+      bool force_matrix_build,
+      double relative_tol)
   {
     if (force_matrix_build)
       {
         integr.ComputeMatrix (pde,matrix_);
+        precondition_->initialize(matrix_);
       }
 
 
-    dealii::SolverControl solver_control (linear_maxiter_, linear_global_tol_,false,false);
+    dealii::ReductionControl solver_control (linear_maxiter_, linear_global_tol_, relative_tol,false,false);
 
     dealii::SolverRichardson<VECTOR> richardson(solver_control);
-    PRECONDITIONER precondition;
-    precondition.initialize(matrix_);
     richardson.solve (matrix_, solution, rhs,
-                      precondition);
+                      *precondition_);
 
     pde.GetDoFConstraints().distribute(solution);
   }
 
+  /******************************************************/
+
+  template <typename PRECONDITIONER,typename SPARSITYPATTERN, typename MATRIX, typename VECTOR>
+  template<typename PROBLEM, typename INTEGRATOR>
+  void RichardsonLinearSolverWithMatrix<PRECONDITIONER,SPARSITYPATTERN,MATRIX,VECTOR>::Solve(PROBLEM &pde,
+      INTEGRATOR &integr,
+      std::vector<VECTOR> &rhs,
+      std::vector<VECTOR> &solution,
+      bool force_matrix_build,
+      double relative_tol)
+  {
+    Assert(rhs.size() == solution.size(), dealii::ExcDimensionMismatch(rhs.size(), solution.size()));
+    for (unsigned int i = 0; i < rhs.size(); i++)
+      {
+        Solve(pde,integr,rhs[i],solution[i],force_matrix_build && (i == 0),relative_tol);
+      }
+  }
+
 
 }
 #endif
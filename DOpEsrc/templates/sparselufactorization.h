@@ -0,0 +1,519 @@
+/**
+*
+* Copyright (C) 2012-2018 by the DOpElib authors
+*
+* This file is part of DOpElib
+*
+* DOpElib is free software: you can redistribute it
+* and/or modify it under the terms of the GNU General Public
+* License as published by the Free Software Foundation, either
+* version 3 of the License, or (at your option) any later
+* version.
+*
+* DOpElib is distributed in the hope that it will be
+* useful, but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* Please refer to the file LICENSE.TXT included in this distribution
+* for further information on this license.
+*
+**/
+
+
+#ifndef SPARSE_LU_FACTORIZATION_H_
+#define SPARSE_LU_FACTORIZATION_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <include/dopeexception.h>
+
+namespace DOpE
+{
+  /**
+   * @class SparseLUFactorization
+   *
+   * A sparse LU factorization P A Q = L U whose factors are stored in the
+   * precision given by `number`. MixedPrecisionDirectLinearSolverWithMatrix
+   * uses it with number = float, then the factors need half of the memory
+   * and memory bandwidth of a double precision factorization with the same fill.
+   *
+   * The factorization is computed column by column by the left looking algorithm
+   * of Gilbert and Peierls with threshold partial pivoting. The column ordering Q
+   * is a minimum degree ordering of the symmetrized pattern of A, computed on the
+   * quotient graph with the approximate external degree of Amestoy, Davis and Duff
+   * (AMD). In each column the diagonal entry is chosen as pivot as long as its
+   * modulus is at least pivot_threshold times the largest modulus of the candidates,
+   * hence the fill is close to the one predicted by the ordering if only few
+   * off-diagonal pivots are needed.
+   *
+   * The triangular solves are done in double precision with the stored factors.
+   *
+   * @tparam <number>    The type of the entries of the factors.
+   */
+  template <typename number>
+  class SparseLUFactorization
+  {
+  public:
+    SparseLUFactorization(double pivot_threshold = 0.1)
+      : pivot_threshold_(pivot_threshold), n_(0)
+    {
+    }
+
+    /**
+     * Computes the factorization of A. MATRIX can be any (block) sparse
+     * matrix of deal.II that provides m(), begin(row) and end(row).
+     * Entries that are zero, except for the diagonal, are dropped.
+     */
+    template <typename MATRIX>
+    void factorize(const MATRIX &A);
+
+    /**
+     * Solves Ax = b, on entry x holds b.
+     */
+    template <typename VECTOR>
+    void solve(VECTOR &x) const;
+
+    /**
+     * Applies the inverse of A, i.e., dst = A^{-1} src.
+     * This allows the use as preconditioner in the deal.II solvers.
+     */
+    template <typename VECTOR>
+    void vmult(VECTOR &dst, const VECTOR &src) const
+    {
+      dst = src;
+      solve(dst);
+    }
+
+    /**
+     * Returns the number of entries stored in L and U.
+     */
+    std::size_t n_nonzero_elements() const
+    {
+      return l_val_.size() + u_val_.size();
+    }
+
+    /**
+     * Returns the memory used by the factors in bytes.
+     */
+    std::size_t memory_consumption() const
+    {
+      return (l_val_.size() + u_val_.size()) * sizeof(number)
+             + (l_row_.size() + u_row_.size() + l_ptr_.size() + u_ptr_.size()
+                + column_order_.size()) * sizeof(unsigned int)
+             + row_pivot_.size() * sizeof(int);
+    }
+
+  private:
+    /**
+     * Computes the approximate minimum degree ordering of the graph of the
+     * columns a_ptr, a_row (symmetrized) and stores it in column_order_.
+     * Supervariables are not detected, hence the ordering is slower
+     * than the one of the AMD library.
+     */
+    void ComputeOrdering(const std::vector<unsigned int> &a_ptr,
+                         const std::vector<unsigned int> &a_row);
+
+    /**
+     * Depth first search in the graph of the already computed columns of L
+     * starting at the row j. The rows reached are stored in xi[top-1], xi[top-2], ...
+     * in topological order.
+     *
+     * @return the new value of top.
+     */
+    unsigned int Dfs(unsigned int j, int k, unsigned int top,
+                     std::vector<unsigned int> &xi,
+                     std::vector<unsigned int> &stack,
+                     std::vector<unsigned int> &pstack,
+                     std::vector<int> &mark) const;
+
+    double pivot_threshold_;
+    unsigned int n_;
+    //L is unit lower triangular, the diagonal is stored first in each column
+    std::vector<unsigned int> l_ptr_, l_row_;
+    std::vector<number> l_val_;
+    //U is upper triangular, the diagonal is stored last in each column
+    std::vector<unsigned int> u_ptr_, u_row_;
+    std::vector<number> u_val_;
+    //column_order_[k] is the column of A eliminated in step k
+    std::vector<unsigned int> column_order_;
+    //row_pivot_[i] is the step in which row i of A is the pivot row
+    std::vector<int> row_pivot_;
+  };
+
+  /**********************************Implementation*******************************************/
+
+  template <typename number>
+  void SparseLUFactorization<number>::ComputeOrdering(const std::vector<unsigned int> &a_ptr,
+                                                      const std::vector<unsigned int> &a_row)
+  {
+    //The quotient graph: the variables adjacent to each variable, the elements,
+    //i.e., the already eliminated variables, adjacent to each variable, and
+    //the variables of each element.
+    std::vector<std::vector<unsigned int> > variables(n_), elements(n_), element_variables(n_);
+    for (unsigned int c = 0; c < n_; c++)
+      for (unsigned int p = a_ptr[c]; p < a_ptr[c+1]; p++)
+        {
+          const unsigned int r = a_row[p];
+          if (r != c)
+            {
+              variables[r].push_back(c);
+              variables[c].push_back(r);
+            }
+        }
+    for (unsigned int i = 0; i < n_; i++)
+      {
+        std::sort(variables[i].begin(), variables[i].end());
+        variables[i].erase(std::unique(variables[i].begin(), variables[i].end()), variables[i].end());
+      }
+
+    //eliminated[i] is true once i is eliminated, absorbed[e] once the
+    //element e is contained in a later element.
+    std::vector<bool> eliminated(n_,false), absorbed(n_,false);
+    std::vector<unsigned int> mark(n_,0);
+    std::vector<int> external(n_,-1);
+    unsigned int tag = 0;
+
+    //The variables are kept in doubly linked lists, one for each degree.
+    const int none = -1;
+    std::vector<int> head(n_,none), next(n_,none), previous(n_,none);
+    std::vector<unsigned int> degree(n_);
+    auto insert = [&](unsigned int i)
+    {
+      next[i] = head[degree[i]];
+      previous[i] = none;
+      if (head[degree[i]] != none)
+        previous[head[degree[i]]] = i;
+      head[degree[i]] = i;
+    };
+    auto remove = [&](unsigned int i)
+    {
+      if (previous[i] != none)
+        next[previous[i]] = next[i];
+      else
+        head[degree[i]] = next[i];
+      if (next[i] != none)
+        previous[next[i]] = previous[i];
+    };
+    for (unsigned int i = n_; i-- > 0;)
+      {
+        degree[i] = variables[i].size();
+        insert(i);
+      }
+
+    column_order_.clear();
+    column_order_.reserve(n_);
+    unsigned int min_degree = 0;
+    while (column_order_.size() < n_)
+      {
+        while (head[min_degree] == none)
+          min_degree++;
+        const unsigned int p = head[min_degree];
+        remove(p);
+        column_order_.push_back(p);
+        eliminated[p] = true;
+
+        //The new element p consists of all variables reachable from p.
+        tag++;
+        mark[p] = tag;
+        std::vector<unsigned int> &lp = element_variables[p];
+        lp.clear();
+        for (unsigned int l = 0; l < variables[p].size(); l++)
+          {
+            const unsigned int i = variables[p][l];
+            if (!eliminated[i] && mark[i] != tag)
+              {
+                mark[i] = tag;
+                lp.push_back(i);
+              }
+          }
+        for (unsigned int l = 0; l < elements[p].size(); l++)
+          {
+            const unsigned int e = elements[p][l];
+            if (absorbed[e])
+              continue;
+            for (unsigned int m = 0; m < element_variables[e].size(); m++)
+              {
+                const unsigned int i = element_variables[e][m];
+                if (!eliminated[i] && mark[i] != tag)
+                  {
+                    mark[i] = tag;
+                    lp.push_back(i);
+                  }
+              }
+            absorbed[e] = true;
+            std::vector<unsigned int>().swap(element_variables[e]);
+          }
+        std::vector<unsigned int>().swap(variables[p]);
+        std::vector<unsigned int>().swap(elements[p]);
+
+        //Update the adjacency of the variables of the new element.
+        //Edges between them are now represented by p.
+        const unsigned int lp_tag = tag;
+        std::vector<unsigned int> touched;
+        for (unsigned int l = 0; l < lp.size(); l++)
+          {
+            const unsigned int i = lp[l];
+            std::vector<unsigned int> &vi = variables[i];
+            vi.erase(std::remove_if(vi.begin(), vi.end(),
+                                    [&](unsigned int j)
+            {
+              return eliminated[j] || mark[j] == lp_tag;
+            }), vi.end());
+            std::vector<unsigned int> &ei = elements[i];
+            ei.erase(std::remove_if(ei.begin(), ei.end(),
+                                    [&](unsigned int e)
+            {
+              return absorbed[e];
+            }), ei.end());
+            //external[e] = |L_e \ L_p|
+            for (unsigned int m = 0; m < ei.size(); m++)
+              {
+                const unsigned int e = ei[m];
+                if (external[e] < 0)
+                  {
+                    external[e] = element_variables[e].size();
+                    touched.push_back(e);
+                  }
+                external[e]--;
+              }
+          }
+
+        //The approximate external degree of Amestoy, Davis and Duff, elements
+        //contained in L_p are absorbed as well.
+        const unsigned int remaining = n_ - column_order_.size();
+        for (unsigned int l = 0; l < lp.size(); l++)
+          {
+            const unsigned int i = lp[l];
+            std::vector<unsigned int> &ei = elements[i];
+            unsigned int d = variables[i].size() + lp.size() - 1;
+            for (unsigned int m = 0; m < ei.size(); m++)
+              {
+                const unsigned int e = ei[m];
+                if (external[e] == 0 && !absorbed[e])
+                  {
+                    absorbed[e] = true;
+                    std::vector<unsigned int>().swap(element_variables[e]);
+                  }
+                d += external[e];
+              }
+            ei.erase(std::remove_if(ei.begin(), ei.end(),
+                                    [&](unsigned int e)
+            {
+              return absorbed[e];
+            }), ei.end());
+            ei.push_back(p);
+            d = std::min(d, std::min(remaining - 1, degree[i] + static_cast<unsigned int>(lp.size()) - 1));
+
+            remove(i);
+            degree[i] = d;
+            insert(i);
+            min_degree = std::min(min_degree, d);
+          }
+        for (unsigned int l = 0; l < touched.size(); l++)
+          external[touched[l]] = -1;
+      }
+  }
+
+  /*******************************************************************************************/
+
+  template <typename number>
+  unsigned int SparseLUFactorization<number>::Dfs(unsigned int j, int k, unsigned int top,
+                                                  std::vector<unsigned int> &xi,
+                                                  std::vector<unsigned int> &stack,
+                                                  std::vector<unsigned int> &pstack,
+                                                  std::vector<int> &mark) const
+  {
+    int head = 0;
+    stack[0] = j;
+    while (head >= 0)
+      {
+        j = stack[head];
+        const int jnew = row_pivot_[j];
+        if (mark[j] != k)
+          {
+            mark[j] = k;
+            pstack[head] = (jnew < 0) ? 0 : l_ptr_[jnew];
+          }
+        bool done = true;
+        const unsigned int p2 = (jnew < 0) ? 0 : l_ptr_[jnew+1];
+        for (unsigned int p = pstack[head]; p < p2; p++)
+          {
+            const unsigned int i = l_row_[p];
+            if (mark[i] == k)
+              continue;
+            pstack[head] = p;
+            stack[++head] = i;
+            done = false;
+            break;
+          }
+        if (done)
+          {
+            head--;
+            xi[--top] = j;
+          }
+      }
+    return top;
+  }
+
+  /*******************************************************************************************/
+
+  template <typename number>
+  template <typename MATRIX>
+  void SparseLUFactorization<number>::factorize(const MATRIX &A)
+  {
+    n_ = A.m();
+
+    //The columns of A, already rounded to number
+    std::vector<unsigned int> a_ptr(n_+1,0);
+    for (unsigned int r = 0; r < n_; r++)
+      for (auto it = A.begin(r); it != A.end(r); ++it)
+        if (it->value() != 0. || it->column() == r)
+          a_ptr[it->column()+1]++;
+    for (unsigned int c = 0; c < n_; c++)
+      a_ptr[c+1] += a_ptr[c];
+    std::vector<unsigned int> a_row(a_ptr[n_]);
+    std::vector<number> a_val(a_ptr[n_]);
+    {
+      std::vector<unsigned int> next(a_ptr.begin(), a_ptr.end()-1);
+      for (unsigned int r = 0; r < n_; r++)
+        for (auto it = A.begin(r); it != A.end(r); ++it)
+          if (it->value() != 0. || it->column() == r)
+            {
+              const unsigned int p = next[it->column()]++;
+              a_row[p] = r;
+              a_val[p] = static_cast<number>(it->value());
+            }
+    }
+
+    ComputeOrdering(a_ptr, a_row);
+
+    l_ptr_.assign(1,0);
+    l_row_.clear();
+    l_val_.clear();
+    u_ptr_.assign(1,0);
+    u_row_.clear();
+    u_val_.clear();
+    row_pivot_.assign(n_,-1);
+
+    std::vector<number> x(n_,0.);
+    std::vector<unsigned int> xi(n_), stack(n_), pstack(n_);
+    std::vector<int> mark(n_,-1);
+
+    for (unsigned int k = 0; k < n_; k++)
+      {
+        const unsigned int col = column_order_[k];
+
+        //Nonzero pattern of x = L^{-1} A(:,col)
+        unsigned int top = n_;
+        for (unsigned int p = a_ptr[col]; p < a_ptr[col+1]; p++)
+          {
+            if (mark[a_row[p]] != static_cast<int>(k))
+              top = Dfs(a_row[p], k, top, xi, stack, pstack, mark);
+          }
+
+        //Sparse triangular solve
+        for (unsigned int px = top; px < n_; px++)
+          x[xi[px]] = 0.;
+        for (unsigned int p = a_ptr[col]; p < a_ptr[col+1]; p++)
+          x[a_row[p]] = a_val[p];
+        for (unsigned int px = top; px < n_; px++)
+          {
+            const unsigned int j = xi[px];
+            const int J = row_pivot_[j];
+            if (J < 0)
+              continue;
+            const number xj = x[j];
+            for (unsigned int p = l_ptr_[J]+1; p < l_ptr_[J+1]; p++)
+              x[l_row_[p]] -= l_val_[p]*xj;
+          }
+
+        //Choice of the pivot, the rows already used as pivot belong to U
+        int ipiv = -1;
+        double amax = 0.;
+        for (unsigned int px = top; px < n_; px++)
+          {
+            const unsigned int i = xi[px];
+            if (row_pivot_[i] < 0)
+              {
+                const double t = std::fabs(x[i]);
+                if (ipiv < 0 || t > amax)
+                  {
+                    amax = t;
+                    ipiv = i;
+                  }
+              }
+            else
+              {
+                u_row_.push_back(row_pivot_[i]);
+                u_val_.push_back(x[i]);
+              }
+          }
+        if (ipiv < 0 || amax == 0.)
+          {
+            throw DOpEException("The matrix is singular.",
+                                "SparseLUFactorization::factorize");
+          }
+        if (row_pivot_[col] < 0 && mark[col] == static_cast<int>(k)
+            && std::fabs(x[col]) >= pivot_threshold_ * amax)
+          ipiv = col;
+
+        const number pivot = x[ipiv];
+        u_row_.push_back(k);
+        u_val_.push_back(pivot);
+        u_ptr_.push_back(u_row_.size());
+
+        row_pivot_[ipiv] = k;
+        l_row_.push_back(ipiv);
+        l_val_.push_back(1.);
+        for (unsigned int px = top; px < n_; px++)
+          {
+            const unsigned int i = xi[px];
+            if (row_pivot_[i] < 0)
+              {
+                l_row_.push_back(i);
+                l_val_.push_back(x[i]/pivot);
+              }
+            x[i] = 0.;
+          }
+        l_ptr_.push_back(l_row_.size());
+      }
+
+    //Rows of L in the order of the pivots
+    for (unsigned int p = 0; p < l_row_.size(); p++)
+      l_row_[p] = row_pivot_[l_row_[p]];
+  }
+
+  /*******************************************************************************************/
+
+  template <typename number>
+  template <typename VECTOR>
+  void SparseLUFactorization<number>::solve(VECTOR &x) const
+  {
+    std::vector<double> y(n_);
+    for (unsigned int i = 0; i < n_; i++)
+      y[row_pivot_[i]] = x(i);
+
+    for (unsigned int j = 0; j < n_; j++)
+      {
+        const double yj = y[j];
+        for (unsigned int p = l_ptr_[j]+1; p < l_ptr_[j+1]; p++)
+          y[l_row_[p]] -= l_val_[p]*yj;
+      }
+    for (unsigned int j = n_; j-- > 0;)
+      {
+        y[j] /= u_val_[u_ptr_[j+1]-1];
+        const double yj = y[j];
+        for (unsigned int p = u_ptr_[j]; p < u_ptr_[j+1]-1; p++)
+          y[u_row_[p]] -= u_val_[p]*yj;
+      }
+
+    for (unsigned int k = 0; k < n_; k++)
+      x(column_order_[k]) = y[k];
+  }
+}
+#endif
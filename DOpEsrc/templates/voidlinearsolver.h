@@ -80,11 +80,11 @@ namespace DOpE
      *                              should be build by the linear solver in the first iteration.
      *            The default is false, meaning that if we have no idea we don't
      *            want to build a matrix.
-     *
+     * @param relative_tol          Ignored.
      *
      */
     template<typename PROBLEM, typename INTEGRATOR>
-    void Solve(PROBLEM &pde, INTEGRATOR &integr, VECTOR &rhs, VECTOR &solution, bool force_matrix_build=false);
+    void Solve(PROBLEM &pde, INTEGRATOR &integr, VECTOR &rhs, VECTOR &solution, bool force_matrix_build=false, double relative_tol=0.);
 
   protected:
 
@@ -126,7 +126,7 @@ namespace DOpE
 
   template <typename VECTOR>
   template<typename PROBLEM, typename INTEGRATOR>
-  void VoidLinearSolver<VECTOR>::Solve(PROBLEM & /*pde*/, INTEGRATOR & /*integr*/, VECTOR &rhs, VECTOR &solution, bool /*force_matrix_build*/)
+  void VoidLinearSolver<VECTOR>::Solve(PROBLEM & /*pde*/, INTEGRATOR & /*integr*/, VECTOR &rhs, VECTOR &solution, bool /*force_matrix_build*/, double /*relative_tol*/)
   {
     solution = rhs;
   }
@@ -0,0 +1,522 @@
+/**
+*
+* Copyright (C) 2012-2018 by the DOpElib authors
+*
+* This file is part of DOpElib
+*
+* DOpElib is free software: you can redistribute it
+* and/or modify it under the terms of the GNU General Public
+* License as published by the Free Software Foundation, either
+* version 3 of the License, or (at your option) any later
+* version.
+*
+* DOpElib is distributed in the hope that it will be
+* useful, but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* Please refer to the file LICENSE.TXT included in this distribution
+* for further information on this license.
+*
+**/
+
+
+#ifndef IMEXRungeKuttaProblem_H_
+#define IMEXRungeKuttaProblem_H_
+
+#include <problemdata/initialproblem.h>
+#include <tsschemes/primal_ts_base.h>
+
+#include <cmath>
+#include <vector>
+
+namespace DOpE
+{
+  /**
+   * @class IMEXRungeKuttaProblem
+   *
+   * Base class for additive implicit-explicit (IMEX) Runge-Kutta schemes
+   * of the type of Ascher, Ruuth and Spiteri. The stiff part of the
+   * ElementEquation is treated with a diagonally implicit scheme, the
+   * non-stiff terms given by the PDE in ElementEquationExplicit with
+   * an explicit scheme. The first stage is u^n, the last stage is u^{n+1}
+   * (stiffly accurate schemes), and stage s = 1,...,GetNStages() solves
+   *
+   * (U_s,\phi) + k a^I_{ss} A_I(U_s)(\phi) = (u^n,\phi)
+   *        - k \sum_{j<s} ( a^I_{sj} A_I(U_j)(\phi) + a^E_{sj} A_E(U_j)(\phi) )
+   *        + k \sum_{j<=s} a^I_{sj} (f(t_n + c_j k),\phi)
+   *
+   * where A_E is ElementEquationExplicit and A_I the remaining part of the
+   * ElementEquation. If A_E is linear, each stage needs only a linear solve
+   * and since all schemes implemented have a constant diagonal a^I_{ss},
+   * the matrix is the same for all stages and can be reused.
+   *
+   * The right-hand side is only evaluated at t_n and t_{n+1} and linearly
+   * interpolated to the stage times, just as the Dirichlet data are taken
+   * at t_{n+1} for all stages. For time dependent data this limits the order
+   * of the schemes to two.
+   *
+   * The step parts given to the InstatStepNewtonSolver are `Old' (the
+   * contributions of u^n), `OldStage' (the contributions of an earlier
+   * stage, see TSBase::SetStage) and `New'. The IMEX schemes are only
+   * available for the state equation.
+   *
+   * All member functions have a corresponding function in BackwardEulerProblem.
+   * For a detailed documentation please consult the corresponding documentation of
+   * BackwardEulerProblem
+   *
+   * @tparam <OPTPROBLEM>       The problem to deal with.
+   * @tparam <SPARSITYPATTERN>  The sparsity pattern for control & state.
+   * @tparam <VECTOR>           The vector type for control & state
+   *                            (i.e. dealii::Vector<double> or dealii::BlockVector<double>)
+   * @tparam <dealdim>          The dimension of the state variable.
+   * @tparam <FE>               The type of finite elements in use, must be compatible with the DH.
+   *
+   */
+  template<typename OPTPROBLEM, typename SPARSITYPATTERN, typename VECTOR,
+           int dealdim, template<int, int> class FE = dealii::FESystem>
+  class IMEXRungeKuttaProblem : public PrimalTSBase<OPTPROBLEM,
+    SPARSITYPATTERN, VECTOR, dealdim, FE>
+  {
+  public:
+    IMEXRungeKuttaProblem(OPTPROBLEM &OP) :
+      PrimalTSBase<OPTPROBLEM, SPARSITYPATTERN, VECTOR, dealdim,
+      FE>(OP)
+    {
+      initial_problem_ = NULL;
+    }
+    ~IMEXRungeKuttaProblem()
+    {
+      if (initial_problem_ != NULL)
+        delete initial_problem_;
+    }
+
+    /******************************************************/
+
+    /**
+     * Returns the number of implicit stages.
+     */
+    unsigned int
+    GetNStages() const
+    {
+      return c_.size() - 1;
+    }
+
+    /******************************************************/
+
+    InitialProblem<
+    IMEXRungeKuttaProblem<OPTPROBLEM, SPARSITYPATTERN, VECTOR,
+                          dealdim, FE>, VECTOR, dealdim>&
+                          GetInitialProblem()
+    {
+      if (initial_problem_ == NULL)
+        {
+          initial_problem_ = new InitialProblem<
+          IMEXRungeKuttaProblem<OPTPROBLEM, SPARSITYPATTERN, VECTOR,
+          dealdim, FE>, VECTOR, dealdim>(*this);
+        }
+      return *initial_problem_;
+    }
+
+    /******************************************************/
+
+    IMEXRungeKuttaProblem<OPTPROBLEM, SPARSITYPATTERN, VECTOR,
+                          dealdim, FE> &
+                          GetBaseProblem()
+    {
+      return *this;
+    }
+
+    /******************************************************/
+
+    template<typename EDC>
+    void
+    ElementEquation(const EDC &edc,
+                    dealii::Vector<double> &local_vector, double scale, double /*scale_ico*/)
+    {
+      const unsigned int s = this->GetStage();
+      if (this->GetPart() == "New")
+        {
+          dealii::Vector<double> tmp(local_vector);
+          tmp = 0.0;
+          this->GetProblem().ElementEquation(edc, tmp,
+                                             scale * a_impl_[s][s],
+                                             scale);
+          this->GetProblem().ElementEquationExplicit(edc, tmp,
+                                                     (-1) * scale * a_impl_[s][s]);
+          local_vector += tmp;
+
+          tmp = 0.0;
+          this->GetProblem().ElementTimeEquation(edc, tmp, scale);
+          local_vector += tmp;
+
+          this->GetProblem().ElementTimeEquationExplicit(edc, local_vector,
+                                                         scale);
+        }
+      else if (this->GetPart() == "Old" || this->GetPart() == "OldStage")
+        {
+          const unsigned int j = (this->GetPart() == "Old") ? 0 : this->GetSourceStage();
+          dealii::Vector<double> tmp(local_vector);
+          tmp = 0.0;
+          if (a_impl_[s][j] != 0.)
+            {
+              this->GetProblem().ElementEquation(edc, tmp,
+                                                 scale * a_impl_[s][j],
+                                                 0.);
+            }
+          if (a_expl_[s][j] != a_impl_[s][j])
+            {
+              this->GetProblem().ElementEquationExplicit(edc, tmp,
+                                                         scale * (a_expl_[s][j] - a_impl_[s][j]));
+            }
+          local_vector += tmp;
+
+          if (j == 0)
+            {
+              this->GetProblem().ElementTimeEquation(edc, local_vector,
+                                                     (-1) * scale);
+            }
+        }
+      else
+        {
+          abort();
+        }
+    }
+
+    /******************************************************/
+
+    template<typename EDC>
+    void
+    ElementRhs(const EDC &edc,
+               dealii::Vector<double> &local_vector, double scale)
+    {
+      const double weight = GetRhsWeight();
+      if (weight != 0.)
+        {
+          this->GetProblem().ElementRhs(edc, local_vector,
+                                        scale * weight);
+        }
+    }
+
+    /******************************************************/
+
+    void
+    PointRhs(
+      const std::map<std::string, const dealii::Vector<double>*> &param_values,
+      const std::map<std::string, const VECTOR *> &domain_values,
+      VECTOR &rhs_vector, double scale)
+    {
+      const double weight = GetRhsWeight();
+      if (weight != 0.)
+        {
+          this->GetProblem().PointRhs(param_values, domain_values, rhs_vector,
+                                      scale * weight);
+        }
+    }
+
+    /******************************************************/
+
+    template<typename EDC>
+    void
+    ElementMatrix(const EDC &edc,
+                  dealii::FullMatrix<double> &local_matrix)
+    {
+      assert(this->GetPart() == "New");
+      const unsigned int s = this->GetStage();
+      dealii::FullMatrix<double> m(local_matrix);
+
+      this->GetProblem().ElementMatrix(edc, local_matrix,
+                                       a_impl_[s][s], 1.);
+
+      m = 0.;
+      this->GetProblem().ElementMatrixExplicit(edc, m, a_impl_[s][s]);
+      local_matrix.add(-1.0, m);
+
+      m = 0.;
+      this->GetProblem().ElementTimeMatrix(edc, m);
+      local_matrix.add(1.0, m);
+
+      m = 0.;
+      this->GetProblem().ElementTimeMatrixExplicit(edc, m);
+      local_matrix.add(1.0, m);
+    }
+
+    /******************************************************/
+
+    template<typename FDC>
+    void
+    FaceEquation(const FDC &fdc,
+                 dealii::Vector<double> &local_vector, double scale,
+                 double /*scale_ico*/)
+    {
+      double weight, weight_ico;
+      GetImplicitWeights(weight, weight_ico);
+      this->GetProblem().FaceEquation(fdc, local_vector,
+                                      scale * weight,
+                                      scale * weight_ico);
+    }
+
+    /******************************************************/
+
+    template<typename FDC>
+    void
+    InterfaceEquation(const FDC &fdc,
+                      dealii::Vector<double> &local_vector, double scale,
+                      double /*scale_ico*/)
+    {
+      double weight, weight_ico;
+      GetImplicitWeights(weight, weight_ico);
+      this->GetProblem().InterfaceEquation(fdc, local_vector,
+                                           scale * weight,
+                                           scale * weight_ico);
+    }
+
+    /******************************************************/
+
+    template<typename FDC>
+    void
+    FaceRhs(const FDC &fdc,
+            dealii::Vector<double> &local_vector, double scale = 1.)
+    {
+      const double weight = GetRhsWeight();
+      if (weight != 0.)
+        {
+          this->GetProblem().FaceRhs(fdc, local_vector,
+                                     scale * weight);
+        }
+    }
+
+    /******************************************************/
+
+    template<typename FDC>
+    void
+    FaceMatrix(const FDC &fdc,
+               dealii::FullMatrix<double> &local_matrix)
+    {
+      assert(this->GetPart() == "New");
+      const unsigned int s = this->GetStage();
+      this->GetProblem().FaceMatrix(fdc, local_matrix,
+                                    a_impl_[s][s], 1.);
+    }
+
+    /******************************************************/
+
+    template<typename FDC>
+    void
+    InterfaceMatrix(const FDC &fdc,
+                    dealii::FullMatrix<double> &local_matrix)
+    {
+      assert(this->GetPart() == "New");
+      const unsigned int s = this->GetStage();
+      this->GetProblem().InterfaceMatrix(fdc, local_matrix,
+                                         a_impl_[s][s], 1.);
+    }
+
+    /******************************************************/
+
+    template<typename FDC>
+    void
+    BoundaryEquation(const FDC &fdc,
+                     dealii::Vector<double> &local_vector, double scale,
+                     double /*scale_ico*/)
+    {
+      double weight, weight_ico;
+      GetImplicitWeights(weight, weight_ico);
+      this->GetProblem().BoundaryEquation(fdc, local_vector,
+                                          scale * weight,
+                                          scale * weight_ico);
+    }
+
+    /******************************************************/
+
+    template<typename FDC>
+    void
+    BoundaryRhs(const FDC &fdc,
+                dealii::Vector<double> &local_vector, double scale)
+    {
+      const double weight = GetRhsWeight();
+      if (weight != 0.)
+        {
+          this->GetProblem().BoundaryRhs(fdc, local_vector,
+                                         scale * weight);
+        }
+    }
+
+    /******************************************************/
+
+    template<typename FDC>
+    void
+    BoundaryMatrix(const FDC &fdc,
+                   dealii::FullMatrix<double> &local_matrix)
+    {
+      assert(this->GetPart() == "New");
+      const unsigned int s = this->GetStage();
+      this->GetProblem().BoundaryMatrix(fdc, local_matrix,
+                                        a_impl_[s][s], 1.);
+    }
+
+  protected:
+    /**
+     * Sets the Butcher tableaus of the scheme. Row and column 0
+     * belong to the explicit first stage u^n, the diagonal of a_impl
+     * must be nonzero for all other stages and the last rows must be
+     * the weights of the schemes.
+     *
+     * @param a_impl    The coefficients of the implicit scheme.
+     * @param a_expl    The coefficients of the explicit scheme.
+     * @param c         The stage times relative to the step size.
+     */
+    void
+    SetTableau(const std::vector<std::vector<double> > &a_impl,
+               const std::vector<std::vector<double> > &a_expl,
+               const std::vector<double> &c)
+    {
+      a_impl_ = a_impl;
+      a_expl_ = a_expl;
+      c_ = c;
+      //Weights of f(t_n) and f(t_{n+1}) in the stages, obtained by
+      //linear interpolation of f(t_n + c_j k).
+      rhs_old_.assign(c_.size(), 0.);
+      rhs_new_.assign(c_.size(), 0.);
+      for (unsigned int s = 1; s < c_.size(); s++)
+        for (unsigned int j = 0; j <= s; j++)
+          {
+            rhs_old_[s] += a_impl_[s][j] * (1. - c_[j]);
+            rhs_new_[s] += a_impl_[s][j] * c_[j];
+          }
+    }
+
+  private:
+    /**
+     * Returns the weight of the right-hand side in the current step part.
+     */
+    double
+    GetRhsWeight() const
+    {
+      if (this->GetPart() == "New")
+        return rhs_new_[this->GetStage()];
+      if (this->GetPart() != "Old" && this->GetPart() != "OldStage")
+        abort();
+      return (this->GetPart() == "Old") ? rhs_old_[this->GetStage()] : 0.;
+    }
+
+    /**
+     * Returns the weights of the face and boundary terms, which are
+     * always treated implicitly, in the current step part.
+     */
+    void
+    GetImplicitWeights(double &weight, double &weight_ico) const
+    {
+      const unsigned int s = this->GetStage();
+      if (this->GetPart() == "New")
+        {
+          weight = a_impl_[s][s];
+          weight_ico = 1.;
+        }
+      else if (this->GetPart() == "Old")
+        {
+          weight = a_impl_[s][0];
+          weight_ico = 0.;
+        }
+      else if (this->GetPart() == "OldStage")
+        {
+          weight = a_impl_[s][this->GetSourceStage()];
+          weight_ico = 0.;
+        }
+      else
+        {
+          abort();
+        }
+    }
+
+    std::vector<std::vector<double> > a_impl_, a_expl_;
+    std::vector<double> c_, rhs_old_, rhs_new_;
+
+    InitialProblem<
+    IMEXRungeKuttaProblem<OPTPROBLEM, SPARSITYPATTERN, VECTOR,
+                          dealdim, FE>, VECTOR, dealdim> * initial_problem_;
+  };
+
+  /**
+   * The second order IMEX scheme ARS(2,2,2) of Ascher, Ruuth and Spiteri
+   * with two implicit stages, L-stable in the implicit part.
+   */
+  template<typename OPTPROBLEM, typename SPARSITYPATTERN, typename VECTOR,
+           int dealdim, template<int, int> class FE = dealii::FESystem>
+  class ARS222Problem : public IMEXRungeKuttaProblem<OPTPROBLEM,
+    SPARSITYPATTERN, VECTOR, dealdim, FE>
+  {
+  public:
+    ARS222Problem(OPTPROBLEM &OP) :
+      IMEXRungeKuttaProblem<OPTPROBLEM, SPARSITYPATTERN, VECTOR, dealdim,
+      FE>(OP)
+    {
+      const double gamma = 1. - std::sqrt(2.) / 2.;
+      const double delta = 1. - 1. / (2. * gamma);
+      std::vector<std::vector<double> > a_impl(3, std::vector<double>(3, 0.));
+      std::vector<std::vector<double> > a_expl(3, std::vector<double>(3, 0.));
+      a_impl[1][1] = gamma;
+      a_impl[2][1] = 1. - gamma;
+      a_impl[2][2] = gamma;
+      a_expl[1][0] = gamma;
+      a_expl[2][0] = delta;
+      a_expl[2][1] = 1. - delta;
+      this->SetTableau(a_impl, a_expl, {0., gamma, 1.});
+    }
+
+    std::string
+    GetName()
+    {
+      return "ARS(2,2,2)";
+    }
+  };
+
+  /**
+   * The third order IMEX scheme ARS(4,4,3) of Ascher, Ruuth and Spiteri
+   * with four implicit stages, L-stable in the implicit part.
+   */
+  template<typename OPTPROBLEM, typename SPARSITYPATTERN, typename VECTOR,
+           int dealdim, template<int, int> class FE = dealii::FESystem>
+  class ARS443Problem : public IMEXRungeKuttaProblem<OPTPROBLEM,
+    SPARSITYPATTERN, VECTOR, dealdim, FE>
+  {
+  public:
+    ARS443Problem(OPTPROBLEM &OP) :
+      IMEXRungeKuttaProblem<OPTPROBLEM, SPARSITYPATTERN, VECTOR, dealdim,
+      FE>(OP)
+    {
+      std::vector<std::vector<double> > a_impl(5, std::vector<double>(5, 0.));
+      std::vector<std::vector<double> > a_expl(5, std::vector<double>(5, 0.));
+      a_impl[1][1] = 1. / 2.;
+      a_impl[2][1] = 1. / 6.;
+      a_impl[2][2] = 1. / 2.;
+      a_impl[3][1] = -1. / 2.;
+      a_impl[3][2] = 1. / 2.;
+      a_impl[3][3] = 1. / 2.;
+      a_impl[4][1] = 3. / 2.;
+      a_impl[4][2] = -3. / 2.;
+      a_impl[4][3] = 1. / 2.;
+      a_impl[4][4] = 1. / 2.;
+      a_expl[1][0] = 1. / 2.;
+      a_expl[2][0] = 11. / 18.;
+      a_expl[2][1] = 1. / 18.;
+      a_expl[3][0] = 5. / 6.;
+      a_expl[3][1] = -5. / 6.;
+      a_expl[3][2] = 1. / 2.;
+      a_expl[4][0] = 1. / 4.;
+      a_expl[4][1] = 7. / 4.;
+      a_expl[4][2] = 3. / 4.;
+      a_expl[4][3] = -7. / 4.;
+      this->SetTableau(a_impl, a_expl, {0., 1. / 2., 2. / 3., 1. / 2., 1.});
+    }
+
+    std::string
+    GetName()
+    {
+      return "ARS(4,4,3)";
+    }
+  };
+}
+
+#endif
@@ -46,7 +46,7 @@ namespace DOpE
   {
   public:
     TSBase(OPTPROBLEM &OP) :
-      OP_(OP)
+      OP_(OP), n_available_time_points_(1), stage_(1), source_stage_(0)
     {
     }
 
@@ -69,6 +69,66 @@ namespace DOpE
 
     /******************************************************/
 
+    /**
+     * Returns the number of previous time points the scheme needs
+     * to compute a time step. One step schemes only need the last
+     * time step solution, multistep schemes overwrite this.
+     */
+    unsigned int
+    GetNPreviousTimePoints() const
+    {
+      return 1;
+    }
+
+    /******************************************************/
+
+    /**
+     * Sets the number of previous time points which are available
+     * for the next time step, i.e., if the time loop provides
+     * "last_last_time_solution" in addition to "last_time_solution".
+     * Multistep schemes use this to start with a one step scheme.
+     *
+     * @param n    Number of available previous time points
+     */
+    void
+    SetNAvailableTimePoints(unsigned int n)
+    {
+      n_available_time_points_ = n;
+    }
+
+    /******************************************************/
+
+    /**
+     * Returns the number of implicit stages which are solved in
+     * one time step. One stage schemes return 1, multistage
+     * Runge-Kutta schemes overwrite this.
+     */
+    unsigned int
+    GetNStages() const
+    {
+      return 1;
+    }
+
+    /******************************************************/
+
+    /**
+     * Sets the stage of a multistage scheme which is computed next,
+     * counted from 1 to GetNStages().
+     *
+     * @param stage          The stage to compute.
+     * @param source_stage   The earlier stage whose solution is evaluated
+     *                       in the step part `OldStage'. Stage 0 is the
+     *                       last time step solution.
+     */
+    void
+    SetStage(unsigned int stage, unsigned int source_stage = 0)
+    {
+      stage_ = stage;
+      source_stage_ = source_stage;
+    }
+
+    /******************************************************/
+
     /**
      * Sets the actual time.
      *
@@ -504,9 +564,39 @@ namespace DOpE
       return part_;
     }
 
+    /******************************************************/
+
+    /**
+     * Returns the number of previous time points available
+     * for the current time step, see SetNAvailableTimePoints.
+     */
+    unsigned int
+    GetNAvailableTimePoints() const
+    {
+      return n_available_time_points_;
+    }
+
+    /******************************************************/
+
+    /**
+     * Returns the stage and source stage given in SetStage.
+     */
+    unsigned int
+    GetStage() const
+    {
+      return stage_;
+    }
+    unsigned int
+    GetSourceStage() const
+    {
+      return source_stage_;
+    }
+
   private:
     OPTPROBLEM &OP_;
     std::string part_;
+    unsigned int n_available_time_points_;
+    unsigned int stage_, source_stage_;
   };
 }
 #endif
@@ -27,6 +27,34 @@
 #include <deal.II/lac/precondition.h>
 #include <deal.II/lac/precondition_block.h>
 #include <deal.II/lac/sparse_ilu.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparse_direct.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/thread_management.h>
+#include <deal.II/base/utilities.h>
+#include <deal.II/dofs/dof_tools.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#ifdef DOPELIB_WITH_TRILINOS
+#include <deal.II/lac/trilinos_precondition.h>
+#include <deal.II/lac/trilinos_sparse_matrix.h>
+
+#include <Epetra_MultiVector.h>
+#include <Teuchos_ParameterList.hpp>
+#include <ml_MultiLevelPreconditioner.h>
+#endif
+
+#include <basic/dopetypes.h>
+#include <include/dopeexception.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
 
 /**
  * @file preconditioner_wrapper.h
@@ -38,6 +66,11 @@
  *
  * Note that they all can be used in the linear solvers by dealii
  * but they do not have the same initialization methods!
+ *
+ * Preconditioners that need more information than the matrix, e.g.,
+ * the DoFHandler to compute the near null space of an AMG, can
+ * obtain it from the problem by an overload of ReInitPreconditioner
+ * which is called by the linear solvers after each ReInit.
  */
 namespace DOpEWrapper
 {
@@ -85,6 +118,119 @@ namespace DOpEWrapper
   };
 
 
+  /**
+   * @class PreconditionDownwindBlockSOR_Wrapper
+   *
+   * A block Gauss-Seidel preconditioner (dealii::PreconditionBlockSOR) for
+   * discontinuous Galerkin discretizations of transport problems with
+   * upwind fluxes, where each block holds the dofs of one element.
+   *
+   * The blocks are processed in downwind order: In the matrix of an upwind
+   * DG method an element only couples to its upwind neighbours. Hence, the blocks
+   * are sorted topologically with respect to the couplings in the matrix,
+   * which makes the matrix block lower triangular, and one sweep of local
+   * block solves is an exact solve, e.g., with RichardsonLinearSolverWithMatrix
+   * the linear solve needs only one iteration.
+   * If the couplings contain cycles, e.g., for recirculating flows, they are broken
+   * at the block with the fewest unprocessed upwind neighbours; the preconditioner
+   * is then a Gauss-Seidel iteration in an approximately downwind order.
+   *
+   * The order is obtained from the assembled matrix (i.e., from the discrete advection
+   * field) in each call of initialize. The blocks are kept in buckets by their number of
+   * unprocessed upwind neighbours, hence the costs, including the breaking of cycles,
+   * are linear in the number of entries.
+   *
+   * It requires that the dofs of each element are numbered consecutively,
+   * as it is the case for FE_DGQ elements.
+   *
+   * @tparam <MATRIX>      The used matrix type
+   * @tparam <blocksize>   The number of dofs per element
+   */
+  template <typename MATRIX,int blocksize>
+  class PreconditionDownwindBlockSOR_Wrapper : public dealii::PreconditionBlockSOR<MATRIX>
+  {
+  public:
+    void initialize(const MATRIX &A)
+    {
+      ComputeDownwindOrdering(A);
+      typename dealii::PreconditionBlockSOR<MATRIX>::AdditionalData data(blocksize,1.);
+      dealii::PreconditionBlockSOR<MATRIX>::initialize(A,permutation_,inverse_permutation_,data);
+    }
+
+  private:
+    /**
+     * Computes the order of the blocks by Kahn's algorithm on the graph of
+     * upwind couplings, where block k is upwind of block l if A_lk is nonzero.
+     * The next block is taken from the lowest nonempty bucket, i.e., from the
+     * blocks without unprocessed upwind neighbours if there are any.
+     */
+    void ComputeDownwindOrdering(const MATRIX &A)
+    {
+      const unsigned int n_blocks = A.m()/blocksize;
+      std::vector<std::vector<unsigned int> > downwind(n_blocks);
+      std::vector<unsigned int> n_upwind(n_blocks,0);
+      for (unsigned int block = 0; block < n_blocks; block++)
+        {
+          std::vector<unsigned int> upwind;
+          for (unsigned int row = block*blocksize; row < (block+1)*blocksize; row++)
+            for (auto it = A.begin(row); it != A.end(row); ++it)
+              {
+                const unsigned int other = it->column()/blocksize;
+                if (other != block && it->value() != 0.)
+                  upwind.push_back(other);
+              }
+          std::sort(upwind.begin(),upwind.end());
+          upwind.erase(std::unique(upwind.begin(),upwind.end()),upwind.end());
+          n_upwind[block] = upwind.size();
+          for (unsigned int i = 0; i < upwind.size(); i++)
+            downwind[upwind[i]].push_back(block);
+        }
+
+      //buckets[c] holds the blocks with c unprocessed upwind neighbours. A block
+      //is added again whenever its count decreases, old entries are skipped.
+      unsigned int max_upwind = 0;
+      for (unsigned int block = 0; block < n_blocks; block++)
+        max_upwind = std::max(max_upwind, n_upwind[block]);
+      std::vector<std::vector<unsigned int> > buckets(max_upwind+1);
+      for (unsigned int block = 0; block < n_blocks; block++)
+        buckets[n_upwind[block]].push_back(block);
+
+      permutation_.clear();
+      permutation_.reserve(n_blocks);
+      std::vector<bool> done(n_blocks,false);
+      unsigned int lowest = 0;
+      while (permutation_.size() < n_blocks)
+        {
+          while (buckets[lowest].empty())
+            lowest++;
+          const unsigned int block = buckets[lowest].back();
+          buckets[lowest].pop_back();
+          if (done[block] || n_upwind[block] != lowest)
+            continue;
+          //If lowest > 0 there is a cycle, which is broken at this block.
+          done[block] = true;
+          permutation_.push_back(block);
+          for (unsigned int i = 0; i < downwind[block].size(); i++)
+            {
+              const unsigned int other = downwind[block][i];
+              if (!done[other])
+                {
+                  --n_upwind[other];
+                  buckets[n_upwind[other]].push_back(other);
+                  lowest = std::min(lowest, n_upwind[other]);
+                }
+            }
+        }
+
+      inverse_permutation_.resize(n_blocks);
+      for (unsigned int i = 0; i < n_blocks; i++)
+        inverse_permutation_[permutation_[i]] = i;
+    }
+
+    std::vector<dealii::types::global_dof_index> permutation_;
+    std::vector<dealii::types::global_dof_index> inverse_permutation_;
+  };
+
   /**
     * @class PreconditionIdentity_Wrapper
     *
@@ -120,11 +266,506 @@ namespace DOpEWrapper
   class PreconditionSparseILU_Wrapper : public dealii::SparseILU<number>
   {
   public:
-    void initialize(const SparseMatrix<number> &A)
+    void initialize(const dealii::SparseMatrix<number> &A)
     {
       dealii::SparseILU<number>::initialize(A);
     }
   };
+
+  /**
+    * @class PreconditionAdditiveSchwarz_Wrapper
+    *
+    * An overlapping additive Schwarz preconditioner
+    *
+    *   P^{-1} = sum_p R_p^T A_p^{-1} R_p
+    *
+    * where R_p restricts to the dofs of the patch p and A_p = R_p A R_p^T
+    * is factorized by UMFPACK. The factorization of the patch matrices in
+    * initialize and the local solves in vmult and Tvmult are done concurrently
+    * by the deal.II task scheduler.
+    *
+    * The patches are constructed as follows: The active cells of the DoFHandler of the problem,
+    * given in ReInitPreconditioner, are sorted along a Hilbert curve through
+    * their centers and split into consecutive groups of cells. Each dof belongs
+    * to the group of the first cell it is found on. If no DoFHandler is known,
+    * or its number of dofs does not match the matrix, the dofs are split into
+    * consecutive index ranges instead.
+    * These nonoverlapping patches are then extended by `overlap` layers
+    * of neighbours in the graph of the matrix.
+    *
+    * By default there are at least as many patches as threads, and
+    * approximately 5000 dofs per patch, see SetNumberOfPatches and SetOverlap.
+    *
+    * @tparam <MATRIX>   The used matrix type, a dealii::SparseMatrix<double>
+    *                    or dealii::BlockSparseMatrix<double>
+    */
+  template <typename MATRIX>
+  class PreconditionAdditiveSchwarz_Wrapper
+  {
+  public:
+    PreconditionAdditiveSchwarz_Wrapper()
+    {
+      n_patches_ = 0;
+      overlap_ = 1;
+    }
+
+    /**
+     * Sets the number of patches, zero means that the number is
+     * chosen from the size of the matrix.
+     */
+    void SetNumberOfPatches(unsigned int n_patches)
+    {
+      n_patches_ = n_patches;
+    }
+
+    /**
+     * Sets the number of layers by which the patches overlap.
+     */
+    void SetOverlap(unsigned int overlap)
+    {
+      overlap_ = overlap;
+    }
+
+    /**
+     * Assigns the dofs to (nonoverlapping) groups of cells
+     * ordered along a Hilbert curve.
+     */
+    template <typename DOFHANDLER>
+    void SetPatches(const DOFHANDLER &dof_handler)
+    {
+      const unsigned int n_patches = GetNumberOfPatches(dof_handler.n_dofs());
+      std::vector<typename DOFHANDLER::active_cell_iterator> cells;
+      for (auto cell = dof_handler.begin_active(); cell != dof_handler.end(); ++cell)
+        cells.push_back(cell);
+#if DEAL_II_VERSION_GTE(9,1,0)
+      const int bits_per_dim = 64/DOFHANDLER::space_dimension;
+      std::vector<dealii::Point<DOFHANDLER::space_dimension> > centers(cells.size());
+      for (unsigned int i = 0; i < cells.size(); i++)
+        centers[i] = cells[i]->center();
+      const auto hilbert_indices
+        = dealii::Utilities::inverse_Hilbert_space_filling_curve(centers, bits_per_dim);
+      std::vector<std::pair<std::uint64_t, unsigned int> > order(cells.size());
+      for (unsigned int i = 0; i < cells.size(); i++)
+        order[i] = std::make_pair(dealii::Utilities::pack_integers<DOFHANDLER::space_dimension>(hilbert_indices[i], bits_per_dim), i);
+      std::sort(order.begin(), order.end());
+#else
+      std::vector<std::pair<unsigned int, unsigned int> > order(cells.size());
+      for (unsigned int i = 0; i < cells.size(); i++)
+        order[i] = std::make_pair(i, i);
+#endif
+
+      const unsigned int unassigned = dealii::numbers::invalid_unsigned_int;
+      dof_to_patch_.assign(dof_handler.n_dofs(), unassigned);
+      std::vector<dealii::types::global_dof_index> local_dof_indices;
+      for (unsigned int i = 0; i < order.size(); i++)
+        {
+          const unsigned int patch = static_cast<unsigned int>((static_cast<std::uint64_t>(i)*n_patches)/order.size());
+          const auto &cell = cells[order[i].second];
+          local_dof_indices.resize(cell->get_fe().dofs_per_cell);
+          cell->get_dof_indices(local_dof_indices);
+          for (unsigned int j = 0; j < local_dof_indices.size(); j++)
+            if (dof_to_patch_[local_dof_indices[j]] == unassigned)
+              dof_to_patch_[local_dof_indices[j]] = patch;
+        }
+    }
+
+    /**
+     * Builds the (overlapping) patches and factorizes the patch matrices.
+     */
+    void initialize(const MATRIX &A)
+    {
+      const unsigned int n = A.m();
+      if (dof_to_patch_.size() != n)
+        {
+          const unsigned int n_patches = GetNumberOfPatches(n);
+          dof_to_patch_.resize(n);
+          for (unsigned int i = 0; i < n; i++)
+            dof_to_patch_[i] = static_cast<unsigned int>((static_cast<std::uint64_t>(i)*n_patches)/n);
+        }
+      unsigned int n_patches = 0;
+      for (unsigned int i = 0; i < n; i++)
+        n_patches = std::max(n_patches, dof_to_patch_[i]+1);
+
+      std::vector<std::vector<unsigned int> > patches(n_patches);
+      for (unsigned int i = 0; i < n; i++)
+        patches[dof_to_patch_[i]].push_back(i);
+      //Skip empty patches, e.g., if there are more patches than cells
+      patch_dofs_.clear();
+      for (unsigned int p = 0; p < n_patches; p++)
+        if (!patches[p].empty())
+          patch_dofs_.push_back(patches[p]);
+      n_patches = patch_dofs_.size();
+
+      patch_solvers_.resize(n_patches);
+      local_solutions_.resize(n_patches);
+
+      dealii::Threads::TaskGroup<void> tasks;
+      for (unsigned int p = 0; p < n_patches; p++)
+        tasks += dealii::Threads::new_task([this, &A, p]()
+        {
+          this->InitializePatch(A, p);
+        });
+      tasks.join_all();
+    }
+
+    template <typename VECTOR>
+    void vmult(VECTOR &dst, const VECTOR &src) const
+    {
+      Apply(dst, src, false);
+    }
+
+    /**
+     * Applies P^{-T} = sum_p R_p^T A_p^{-T} R_p, i.e., the same
+     * as vmult but with transposed local solves.
+     */
+    template <typename VECTOR>
+    void Tvmult(VECTOR &dst, const VECTOR &src) const
+    {
+      Apply(dst, src, true);
+    }
+
+  private:
+    template <typename VECTOR>
+    void Apply(VECTOR &dst, const VECTOR &src, bool transpose) const
+    {
+      dealii::Threads::TaskGroup<void> tasks;
+      for (unsigned int p = 0; p < patch_dofs_.size(); p++)
+        tasks += dealii::Threads::new_task([this, &src, p, transpose]()
+        {
+          this->SolvePatch(src, p, transpose);
+        });
+      tasks.join_all();
+
+      dst = 0.;
+      for (unsigned int p = 0; p < patch_dofs_.size(); p++)
+        for (unsigned int i = 0; i < patch_dofs_[p].size(); i++)
+          dst(patch_dofs_[p][i]) += local_solutions_[p](i);
+    }
+
+    unsigned int GetNumberOfPatches(unsigned int n_dofs) const
+    {
+      if (n_patches_ > 0)
+        return n_patches_;
+      return std::max(dealii::MultithreadInfo::n_threads(), n_dofs/5000+1);
+    }
+
+    /**
+     * Extends the dofs of the patch p by overlap_ layers in the
+     * graph of A, extracts A_p and factorizes it.
+     */
+    void InitializePatch(const MATRIX &A, unsigned int p)
+    {
+      std::vector<unsigned int> &dofs = patch_dofs_[p];
+      for (unsigned int layer = 0; layer < overlap_; layer++)
+        {
+          std::vector<unsigned int> extended(dofs);
+          for (unsigned int i = 0; i < dofs.size(); i++)
+            for (auto it = A.begin(dofs[i]); it != A.end(dofs[i]); ++it)
+              extended.push_back(it->column());
+          std::sort(extended.begin(), extended.end());
+          extended.erase(std::unique(extended.begin(), extended.end()), extended.end());
+          dofs.swap(extended);
+        }
+
+      const unsigned int n_local = dofs.size();
+      dealii::DynamicSparsityPattern dsp(n_local, n_local);
+      for (unsigned int i = 0; i < n_local; i++)
+        for (auto it = A.begin(dofs[i]); it != A.end(dofs[i]); ++it)
+          {
+            auto pos = std::lower_bound(dofs.begin(), dofs.end(), it->column());
+            if (pos != dofs.end() && *pos == it->column())
+              dsp.add(i, pos-dofs.begin());
+          }
+      dealii::SparsityPattern sparsity;
+      sparsity.copy_from(dsp);
+      dealii::SparseMatrix<double> local_matrix(sparsity);
+      for (unsigned int i = 0; i < n_local; i++)
+        for (auto it = A.begin(dofs[i]); it != A.end(dofs[i]); ++it)
+          {
+            auto pos = std::lower_bound(dofs.begin(), dofs.end(), it->column());
+            if (pos != dofs.end() && *pos == it->column())
+              local_matrix.set(i, pos-dofs.begin(), it->value());
+          }
+
+      patch_solvers_[p].reset(new dealii::SparseDirectUMFPACK);
+      patch_solvers_[p]->initialize(local_matrix);
+      local_solutions_[p].reinit(n_local);
+    }
+
+    template <typename VECTOR>
+    void SolvePatch(const VECTOR &src, unsigned int p, bool transpose) const
+    {
+      dealii::Vector<double> &local = local_solutions_[p];
+      for (unsigned int i = 0; i < patch_dofs_[p].size(); i++)
+        local(i) = src(patch_dofs_[p][i]);
+      patch_solvers_[p]->solve(local, transpose);
+    }
+
+    unsigned int n_patches_, overlap_;
+    std::vector<unsigned int> dof_to_patch_;
+    std::vector<std::vector<unsigned int> > patch_dofs_;
+    std::vector<std::unique_ptr<dealii::SparseDirectUMFPACK> > patch_solvers_;
+    mutable std::vector<dealii::Vector<double> > local_solutions_;
+  };
+
+#ifdef DOPELIB_WITH_TRILINOS
+  /**
+    * @class PreconditionAMG_Wrapper
+    *
+    * Wrapper for the dealii::TrilinosWrappers::PreconditionAMG preconditioner
+    * (smoothed aggregation AMG of Trilinos ML).
+    *
+    * The near null space is given by the constant modes of each
+    * component of the DoFHandler of the problem (the control DoFHandler
+    * for control problems, the state DoFHandler otherwise), these are
+    * computed in ReInitPreconditioner.
+    *
+    * The multilevel hierarchy is set up completely in the first call of
+    * initialize after the preconditioner has been created, i.e., after each
+    * ReInit of the linear solver. Since the linear solvers call initialize
+    * only if the matrix has been rebuild, all following calls are
+    * matrix updates on the same sparsity pattern and reuse the aggregation
+    * of the first setup (dealii::TrilinosWrappers::PreconditionAMG::reinit).
+    *
+    * @tparam <MATRIX>   The used matrix type, needs to be a
+    *                    TrilinosWrappers::SparseMatrix
+    */
+  template <typename MATRIX>
+  class PreconditionAMG_Wrapper : public dealii::TrilinosWrappers::PreconditionAMG
+  {
+  public:
+    PreconditionAMG_Wrapper()
+    {
+      n_setups_ = 0;
+    }
+
+    /**
+     * Computes the constant modes for each component of the
+     * given DoFHandler to be used as near null space.
+     */
+    template <typename DOFHANDLER>
+    void SetNearNullSpace(const DOFHANDLER &dof_handler)
+    {
+      dealii::ComponentMask all_components(dof_handler.get_fe().n_components(), true);
+      dealii::DoFTools::extract_constant_modes(dof_handler, all_components, constant_modes_);
+    }
+
+    void initialize(const MATRIX &A)
+    {
+      if (n_setups_ == 0)
+        {
+          dealii::TrilinosWrappers::PreconditionAMG::AdditionalData data;
+          data.elliptic = true;
+          data.higher_order_elements = false;
+          data.smoother_sweeps = 2;
+          data.aggregation_threshold = 1.e-4;
+          data.constant_modes = constant_modes_;
+          dealii::TrilinosWrappers::PreconditionAMG::initialize(A,data);
+        }
+      else
+        {
+          dealii::TrilinosWrappers::PreconditionAMG::reinit();
+        }
+      n_setups_++;
+    }
+
+  private:
+    std::vector<std::vector<bool> > constant_modes_;
+    unsigned int n_setups_;
+  };
+
+  /**
+    * @class PreconditionAMGElasticity_Wrapper
+    *
+    * Wrapper for the dealii::TrilinosWrappers::PreconditionAMG preconditioner
+    * for (vector valued) elasticity problems.
+    *
+    * The near null space is spanned by the rigid body modes of the
+    * displacement, i.e., the first dim components of the FESystem, which are
+    * computed from the support points of the DoFHandler of the problem
+    * (dim translations and 1 (dim=2) or 3 (dim=3) rotations).
+    * Each further component, e.g. a pressure or a phase-field, adds its
+    * constant mode. The modes are passed to ML by its parameter list.
+    *
+    * The reuse of the hierarchy follows PreconditionAMG_Wrapper.
+    *
+    * @tparam <MATRIX>   The used matrix type, needs to be a
+    *                    TrilinosWrappers::SparseMatrix
+    * @tparam <dim>      The dimension of the displacement.
+    */
+  template <typename MATRIX, int dim>
+  class PreconditionAMGElasticity_Wrapper : public dealii::TrilinosWrappers::PreconditionAMG
+  {
+  public:
+    PreconditionAMGElasticity_Wrapper()
+    {
+      n_setups_ = 0;
+      n_components_ = dim;
+    }
+
+    /**
+     * Stores support points and components of the locally owned
+     * DoFs of the given DoFHandler needed to compute the rigid body modes.
+     */
+    template <typename DOFHANDLER>
+    void SetNearNullSpace(const DOFHANDLER &dof_handler)
+    {
+      support_points_.clear();
+      dof_components_.clear();
+      dealii::DoFTools::map_dofs_to_support_points(dealii::StaticMappingQ1<dim>::mapping,
+                                                   dof_handler, support_points_);
+
+      std::vector<dealii::types::global_dof_index> local_dof_indices;
+      typename DOFHANDLER::active_cell_iterator cell = dof_handler.begin_active();
+      typename DOFHANDLER::active_cell_iterator endc = dof_handler.end();
+      for (; cell != endc; ++cell)
+        {
+          if (!cell->is_locally_owned())
+            continue;
+          const dealii::FiniteElement<dim> &fe = cell->get_fe();
+          n_components_ = fe.n_components();
+          local_dof_indices.resize(fe.dofs_per_cell);
+          cell->get_dof_indices(local_dof_indices);
+          for (unsigned int i = 0; i < fe.dofs_per_cell; i++)
+            dof_components_[local_dof_indices[i]] = fe.system_to_component_index(i).first;
+        }
+    }
+
+    void initialize(const MATRIX &A)
+    {
+      if (n_setups_ == 0)
+        {
+          const Epetra_Map &map = A.trilinos_matrix().DomainMap();
+          const unsigned int n_rotations = (dim == 2) ? 1 : 3;
+          const unsigned int n_modes = dim + n_rotations + (n_components_ - dim);
+
+          null_space_.reset(new Epetra_MultiVector(map, n_modes));
+          null_space_->PutScalar(0.);
+          std::map<dealii::types::global_dof_index, unsigned int>::const_iterator it
+            = dof_components_.begin();
+          for (; it != dof_components_.end(); it++)
+            {
+              const int lid = map.LID(static_cast<dealii::TrilinosWrappers::types::int_type>(it->first));
+              if (lid < 0)
+                continue;
+              const unsigned int c = it->second;
+              if (c >= dim)
+                {
+                  (*null_space_)[dim + n_rotations + c - dim][lid] = 1.;
+                  continue;
+                }
+              const dealii::Point<dim> &x = support_points_[it->first];
+              //Translations
+              (*null_space_)[c][lid] = 1.;
+              //Rotations
+              if (dim == 2)
+                {
+                  (*null_space_)[dim][lid] = (c == 0) ? -x[1] : x[0];
+                }
+              else
+                {
+                  //around z
+                  (*null_space_)[dim][lid] = (c == 0) ? -x[1] : ((c == 1) ? x[0] : 0.);
+                  //around x
+                  (*null_space_)[dim+1][lid] = (c == 1) ? -x[dim-1] : ((c == 2) ? x[1] : 0.);
+                  //around y
+                  (*null_space_)[dim+2][lid] = (c == 0) ? x[dim-1] : ((c == 2) ? -x[0] : 0.);
+                }
+            }
+
+          Teuchos::ParameterList parameter_list;
+          ML_Epetra::SetDefaults("SA", parameter_list);
+          parameter_list.set("ML output", 0);
+          parameter_list.set("smoother: type", "Chebyshev");
+          parameter_list.set("smoother: sweeps", 2);
+          parameter_list.set("aggregation: threshold", 1.e-4);
+          parameter_list.set("coarse: max size", 2000);
+          parameter_list.set("null space: type", "pre-computed");
+          parameter_list.set("null space: dimension", static_cast<int>(n_modes));
+          parameter_list.set("null space: vectors", null_space_->Values());
+
+          dealii::TrilinosWrappers::PreconditionAMG::initialize(A,parameter_list);
+        }
+      else
+        {
+          dealii::TrilinosWrappers::PreconditionAMG::reinit();
+        }
+      n_setups_++;
+    }
+
+  private:
+    std::map<dealii::types::global_dof_index, dealii::Point<dim> > support_points_;
+    std::map<dealii::types::global_dof_index, unsigned int> dof_components_;
+    std::unique_ptr<Epetra_MultiVector> null_space_;
+    unsigned int n_components_;
+    unsigned int n_setups_;
+  };
+#endif
+
+  /**
+   * Passes information of the problem to the preconditioner
+   * once the linear solver is reinitialized, e.g., after a change of the mesh.
+   *
+   * The default does nothing, as most preconditioners
+   * only need the matrix.
+   */
+  template <typename PRECONDITIONER, typename PROBLEM>
+  void
+  ReInitPreconditioner(PRECONDITIONER & /*precondition*/, PROBLEM & /*pde*/)
+  {
+  }
+
+  /**
+   * Returns the index of the DoFHandler in the vector
+   * GetDoFHandler() of the SpaceTimeHandler on which the matrix of the
+   * problem is assembled, i.e., the control DoFHandler if the
+   * problem has control DoFs (types gradient and hessian) and the
+   * state DoFHandler otherwise.
+   */
+  template <typename PROBLEM>
+  unsigned int
+  GetPreconditionerDoFHandlerIndex(PROBLEM &pde)
+  {
+    auto &sth = *(pde.GetBaseProblem().GetSpaceTimeHandler());
+    const unsigned int state_index = sth.GetStateIndex();
+    if (pde.GetDoFType() == DOpEtypes::control)
+      {
+        if (sth.GetDoFHandler().size() != 2)
+          {
+            throw DOpEException("The control of the problem of type " + pde.GetType()
+                                + " has no DoFHandler on the mesh of the state.",
+                                "DOpEWrapper::GetPreconditionerDoFHandlerIndex");
+          }
+        return (state_index == 1) ? 0 : 1;
+      }
+    return state_index;
+  }
+
+  template <typename MATRIX, typename PROBLEM>
+  void
+  ReInitPreconditioner(PreconditionAdditiveSchwarz_Wrapper<MATRIX> &precondition, PROBLEM &pde)
+  {
+    const unsigned int index = GetPreconditionerDoFHandlerIndex(pde);
+    precondition.SetPatches(pde.GetBaseProblem().GetSpaceTimeHandler()->GetDoFHandler()[index]->GetDEALDoFHandler());
+  }
+
+#ifdef DOPELIB_WITH_TRILINOS
+  template <typename MATRIX, typename PROBLEM>
+  void
+  ReInitPreconditioner(PreconditionAMG_Wrapper<MATRIX> &precondition, PROBLEM &pde)
+  {
+    const unsigned int index = GetPreconditionerDoFHandlerIndex(pde);
+    precondition.SetNearNullSpace(pde.GetBaseProblem().GetSpaceTimeHandler()->GetDoFHandler()[index]->GetDEALDoFHandler());
+  }
+
+  template <typename MATRIX, int dim, typename PROBLEM>
+  void
+  ReInitPreconditioner(PreconditionAMGElasticity_Wrapper<MATRIX,dim> &precondition, PROBLEM &pde)
+  {
+    const unsigned int index = GetPreconditionerDoFHandlerIndex(pde);
+    precondition.SetNearNullSpace(pde.GetBaseProblem().GetSpaceTimeHandler()->GetDoFHandler()[index]->GetDEALDoFHandler());
+  }
+#endif
 }
 
 #endif
@@ -0,0 +1,323 @@
+/**
+ *
+ * Copyright (C) 2012-2018 by the DOpElib authors
+ *
+ * This file is part of DOpElib
+ *
+ * DOpElib is free software: you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * DOpElib is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * Please refer to the file LICENSE.TXT included in this distribution
+ * for further information on this license.
+ *
+ **/
+
+//c++ includes
+#include <iostream>
+#include <fstream>
+
+//deal.ii includes
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/function.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_nothing.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_in.h>
+#if DEAL_II_VERSION_GTE(9,1,1)
+#else
+#include <deal.II/grid/tria_boundary_lib.h>
+#endif
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/base/function.h>
+#if DEAL_II_VERSION_GTE(9,0,0)
+#include <deal.II/grid/manifold_lib.h>
+#endif
+
+//DOpE includes
+#include <include/parameterreader.h>
+#include <templates/gmresrecyclinglinearsolver.h>
+#include <templates/directlinearsolver.h>
+#include <wrapper/preconditioner_wrapper.h>
+#include <templates/integrator.h>
+#include <basic/mol_statespacetimehandler.h>
+#include <problemdata/simpledirichletdata.h>
+#include <container/integratordatacontainer.h>
+#include <templates/newtonsolver.h>
+#include <interfaces/functionalinterface.h>
+
+
+//DOpE includes for instationary problems
+#include <reducedproblems/instatpdeproblem.h>
+#include <templates/instat_step_newtonsolver.h>
+#include <container/instatpdeproblemcontainer.h>
+
+//various timestepping schemes
+//#include <tsschemes/forward_euler_problem.h>
+//#include <tsschemes/backward_euler_problem.h>
+//#include <tsschemes/crank_nicolson_problem.h>
+#include <tsschemes/shifted_crank_nicolson_problem.h>
+
+//Problem specific includes
+#include "localpde.h"
+#include "functionals.h"
+#include "my_functions.h"
+
+using namespace std;
+using namespace dealii;
+using namespace DOpE;
+
+const static int DIM = 2;
+
+#if DEAL_II_VERSION_GTE(9,3,0)
+#define DOFHANDLER false
+#else
+#define DOFHANDLER DoFHandler
+#endif
+
+#define FE FESystem
+#define EDC ElementDataContainer
+#define FDC FaceDataContainer
+
+typedef QGauss<DIM> QUADRATURE;
+typedef QGauss<DIM - 1> FACEQUADRATURE;
+typedef SparseMatrix<double> MATRIX;
+typedef SparsityPattern SPARSITYPATTERN;
+typedef Vector<double> VECTOR;
+
+typedef PDEProblemContainer<
+LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM>,
+         SimpleDirichletData<VECTOR, DIM>,
+         SPARSITYPATTERN,
+         VECTOR, DIM> OP_BASE;
+
+typedef StateProblem<OP_BASE, LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM>,
+        SimpleDirichletData<VECTOR, DIM>, SPARSITYPATTERN, VECTOR, DIM> PROB;
+
+// Typedefs for timestep problem
+#define TSP ShiftedCrankNicolsonProblem
+//FIXME: This should be a reasonable dual timestepping scheme
+#define DTSP ShiftedCrankNicolsonProblem
+typedef InstatPDEProblemContainer<TSP, DTSP,
+        LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM>,
+        SimpleDirichletData<VECTOR, DIM>, SPARSITYPATTERN,
+        VECTOR, DIM> OP;
+#undef TSP
+#undef DTSP
+
+typedef IntegratorDataContainer<DOFHANDLER, QUADRATURE,
+        FACEQUADRATURE, VECTOR, DIM> IDC;
+typedef Integrator<IDC, VECTOR, double, DIM> INTEGRATOR;
+//The linear systems of all Newton steps in all time steps are solved by
+//an ILU preconditioned GMRES method that recycles its search directions.
+typedef DOpEWrapper::PreconditionSparseILU_Wrapper<double> PRECONDITIONER;
+typedef GMRESRecyclingLinearSolverWithMatrix<PRECONDITIONER, SPARSITYPATTERN, MATRIX, VECTOR> LINEARSOLVER;
+typedef InstatStepNewtonSolver<INTEGRATOR, LINEARSOLVER, VECTOR> NLS;
+typedef InstatPDEProblem<NLS, INTEGRATOR, OP, VECTOR, DIM> RP;
+//The reference solution is computed with a direct linear solver.
+typedef DirectLinearSolverWithMatrix<SPARSITYPATTERN, MATRIX, VECTOR> DIRECTLINEARSOLVER;
+typedef InstatStepNewtonSolver<INTEGRATOR, DIRECTLINEARSOLVER, VECTOR> NLSDIRECT;
+typedef InstatPDEProblem<NLSDIRECT, INTEGRATOR, OP, VECTOR, DIM> RPDIRECT;
+
+int
+main(int argc, char **argv)
+{
+  /**
+   *  In this example we solve the instationary Navier Stokes' equations
+   *  as in Example1, but with an iterative linear solver that recycles
+   *  a deflation subspace over all Newton steps and time steps.
+   *  The solution is compared with the one of a direct linear solver.
+   */
+
+  dealii::Utilities::MPI::MPI_InitFinalize mpi(argc, argv);
+
+  string paramfile = "dope.prm";
+
+  if (argc == 2)
+    {
+      paramfile = argv[1];
+    }
+  else if (argc > 2)
+    {
+      std::cout << "Usage: " << argv[0] << " [ paramfile ] " << std::endl;
+      return -1;
+    }
+
+  ParameterReader pr;
+  RP::declare_params(pr);
+  RPDIRECT::declare_params(pr);
+  DOpEOutputHandler<VECTOR>::declare_params(pr);
+  LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM>::declare_params(pr);
+  BoundaryParabel::declare_params(pr);
+  LocalBoundaryFunctionalDrag<EDC, FDC, DOFHANDLER, VECTOR, DIM, DIM>::declare_params(
+    pr);
+  LocalBoundaryFunctionalLift<EDC, FDC, DOFHANDLER, VECTOR, DIM, DIM>::declare_params(
+    pr);
+  pr.read_parameters(paramfile);
+
+  /*** Create the triangulation*********************************/
+  Triangulation<DIM> triangulation;
+  GridIn<DIM> grid_in;
+  grid_in.attach_triangulation(triangulation);
+  //std::ifstream input_file("channel.inp");
+  std::ifstream input_file("nsbench4_original.inp");
+  grid_in.read_ucd(input_file);
+  /**********************************************/
+
+  Point<DIM> p(0.2, 0.2);
+#if DEAL_II_VERSION_GTE(9,0,0)
+  static const SphericalManifold<DIM> boundary(p);
+  triangulation.set_all_manifold_ids_on_boundary(80,80);
+  triangulation.set_manifold(80,boundary);
+#else
+  double radius = 0.05;
+  static const HyperBallBoundary<DIM> boundary(p, radius);
+  triangulation.set_boundary(80, boundary);
+#endif
+  triangulation.refine_global(2);
+
+  FE<DIM> state_fe(FE_Q<DIM>(2), 2, FE_Q<DIM>(1), 1);
+
+  QUADRATURE quadrature_formula(3);
+  FACEQUADRATURE face_quadrature_formula(3);
+  IDC idc(quadrature_formula, face_quadrature_formula);
+
+  LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM> LPDE(pr);
+
+  LocalPointFunctionalPressure<EDC, FDC, DOFHANDLER, VECTOR, DIM, DIM> LPFP;
+  LocalBoundaryFunctionalDrag<EDC, FDC, DOFHANDLER, VECTOR, DIM, DIM> LBFD(pr);
+  LocalBoundaryFunctionalLift<EDC, FDC, DOFHANDLER, VECTOR, DIM, DIM> LBFL(pr);
+
+  // Create a time grid of [0,2] with
+  // 20 subintervalls for the timediscretization.
+  Triangulation<1> times;
+  GridGenerator::subdivided_hyper_cube(times, 20, 0, 2);
+
+  // We give the spatial and time triangulation as well as the state/control finite
+  // elements to the MOL-space time handler. DOpEtypes::undefined marks
+  // the type of the control, see dopetypes.h for more information.
+  MethodOfLines_StateSpaceTimeHandler<FE, DOFHANDLER, SPARSITYPATTERN, VECTOR, DIM>
+  DOFH(triangulation, state_fe, times);
+
+  OP P(LPDE, DOFH);
+
+  P.AddFunctional(&LPFP);
+  P.AddFunctional(&LBFD);
+  P.AddFunctional(&LBFL);
+
+  // We want to evaluate drag and lift at the enclosed cylinder,
+  // which has the boundary color 80.
+  P.SetBoundaryFunctionalColors(80);
+
+  std::vector<bool> comp_mask(3);
+
+  comp_mask[0] = true;
+  comp_mask[1] = true;
+  comp_mask[2] = false;
+
+  // Define the noslip boundary conditions...
+  DOpEWrapper::ZeroFunction<DIM> zf(3);
+  SimpleDirichletData<VECTOR, DIM> DD1(zf);
+
+  //... and the inflow values.
+  BoundaryParabel boundary_parabel(pr);
+  SimpleDirichletData<VECTOR, DIM> DD2(boundary_parabel);
+
+  P.SetDirichletBoundaryColors(0, comp_mask, &DD2);
+  P.SetDirichletBoundaryColors(2, comp_mask, &DD1);
+  P.SetDirichletBoundaryColors(80, comp_mask, &DD1);
+
+  P.SetBoundaryEquationColors(1);
+
+  //We use zero initial values.
+  P.SetInitialValues(&zf);
+//  BoundaryParabelExact boundary_parabel_ex;
+//  P.SetInitialValues(&boundary_parabel_ex);
+
+  RP solver(&P, DOpEtypes::VectorStorageType::fullmem, pr, idc);
+  RPDIRECT solver_direct(&P, DOpEtypes::VectorStorageType::fullmem, pr, idc);
+
+  //Only needed for pure PDE Problems: We define and register
+  //the output- and exception handler. The first handels the
+  //output on the screen as well as the output of files. The
+  //amount of the output can be steered by the paramfile.
+  DOpEOutputHandler<VECTOR> out(&solver, pr);
+  DOpEExceptionHandler<VECTOR> ex(&out);
+  P.RegisterOutputHandler(&out);
+  P.RegisterExceptionHandler(&ex);
+  solver.RegisterOutputHandler(&out);
+  solver.RegisterExceptionHandler(&ex);
+  solver_direct.RegisterOutputHandler(&out);
+  solver_direct.RegisterExceptionHandler(&ex);
+
+  try
+    {
+      //Before solving we have to reinitialize the stateproblem and outputhandler.
+      solver.ReInit();
+      solver_direct.ReInit();
+      out.ReInit();
+
+      stringstream outp;
+      outp << "**************************************************\n";
+      outp << "*     Starting Forward Solve - Recycling GMRES   *\n";
+      outp << "*   Solving : " << P.GetName() << "\t*\n";
+      outp << "*   SDoFs   : ";
+      solver.StateSizeInfo(outp);
+      outp << "**************************************************";
+      //We print this header with priority 1 and 1 empty line in front and after.
+      out.Write(outp, 1, 1, 1);
+
+      //We compute the value of the functionals. To this end, we have to solve
+      //the PDE at hand.
+      solver.ComputeReducedFunctionals();
+
+      outp << "**************************************************\n";
+      outp << "*     Starting Forward Solve - Direct Solver     *\n";
+      outp << "*   Solving : " << P.GetName() << "\t*\n";
+      outp << "*   SDoFs   : ";
+      solver_direct.StateSizeInfo(outp);
+      outp << "**************************************************";
+      out.Write(outp, 1, 1, 1);
+
+      solver_direct.ComputeReducedFunctionals();
+
+      //Both linear solvers give the same Newton iterates up to the
+      //tolerances, hence the solutions agree.
+      SolutionExtractor<RP, VECTOR> a1(solver);
+      SolutionExtractor<RPDIRECT, VECTOR> a2(solver_direct);
+      const StateVector<VECTOR> &u_direct = a2.GetU();
+      SpaceTimeVector<VECTOR> difference(a1.GetU());
+      difference.equ(1., a1.GetU());
+      difference.add(-1., u_direct);
+      const double relative_difference = std::sqrt((difference * difference)
+                                                   / (u_direct * u_direct));
+
+      outp << "Recycling GMRES solution agrees with direct solution: "
+           << ((relative_difference < 1.e-6) ? "yes" : "no");
+      out.Write(outp, 0, 1, 0);
+    }
+  catch (DOpEException &e)
+    {
+      std::cout
+          << "Warning: During execution of `" + e.GetThrowingInstance()
+          + "` the following Problem occurred!" << std::endl;
+      std::cout << e.GetErrorMessage() << std::endl;
+    }
+
+  return 0;
+}
+
+#undef FDC
+#undef EDC
+#undef FE
+#undef DOFHANDLER
+
@@ -0,0 +1,10 @@
+#!/bin/bash
+if [ $# -ne 1 ]
+    then
+    echo "Usage: "$0" [Test|Store]"
+    exit 1
+fi
+
+PROGRAM=../DOpE-PDE-InstatPDE-Example14
+
+bash ../../../../test-single.sh $1 $PROGRAM
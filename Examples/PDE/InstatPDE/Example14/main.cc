@@ -0,0 +1,269 @@
+/**
+ *
+ * Copyright (C) 2012-2018 by the DOpElib authors
+ *
+ * This file is part of DOpElib
+ *
+ * DOpElib is free software: you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * DOpElib is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * Please refer to the file LICENSE.TXT included in this distribution
+ * for further information on this license.
+ *
+ **/
+
+//c++ includes
+#include <iostream>
+#include <fstream>
+
+//deal.ii includes
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/function.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_dgp.h> //for discont. finite elements
+#include <deal.II/fe/fe_nothing.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_in.h>
+#if DEAL_II_VERSION_GTE(9,1,1)
+#else
+#include <deal.II/grid/tria_boundary_lib.h>
+#endif
+#include <deal.II/grid/grid_generator.h>
+
+//DOpE includes
+#include <include/parameterreader.h>
+#include <templates/directlinearsolver.h>
+#include <templates/integrator.h>
+#include <basic/mol_statespacetimehandler.h>
+#include <problemdata/simpledirichletdata.h>
+#include <container/integratordatacontainer.h>
+#include <templates/instat_step_newtonsolver.h>
+#include <templates/instat_step_andersonsolver.h>
+
+#include <reducedproblems/instatpdeproblem.h>
+#include <container/instatpdeproblemcontainer.h>
+
+#include <tsschemes/backward_euler_problem.h>
+
+//Problem specific includes
+#include "localpde.h"
+#include "functionals.h"
+#include "my_functions.h"
+
+using namespace std;
+using namespace dealii;
+using namespace DOpE;
+
+// Define dimensions for control- and state problem
+const static int DIM = 2;
+
+#if DEAL_II_VERSION_GTE(9,3,0)
+#define DOFHANDLER false
+#else
+#define DOFHANDLER DoFHandler
+#endif
+
+#define FE FESystem
+#define EDC ElementDataContainer
+#define FDC FaceDataContainer
+
+typedef QGauss<DIM> QUADRATURE;
+typedef QGauss<DIM - 1> FACEQUADRATURE;
+typedef BlockSparseMatrix<double> MATRIX;
+typedef BlockSparsityPattern SPARSITYPATTERN;
+typedef BlockVector<double> VECTOR;
+
+typedef PDEProblemContainer<
+LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM>,
+         SimpleDirichletData<VECTOR, DIM>,
+         SPARSITYPATTERN,
+         VECTOR, DIM> OP_BASE;
+
+typedef StateProblem<OP_BASE, LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM>,
+        SimpleDirichletData<VECTOR, DIM>, SPARSITYPATTERN, VECTOR, DIM> PROB;
+
+#define TSP BackwardEulerProblem
+//FIXME: This should be a reasonable dual timestepping scheme
+#define DTSP BackwardEulerProblem
+
+typedef InstatPDEProblemContainer<TSP, DTSP,
+        LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM>,
+        SimpleDirichletData<VECTOR, DIM>,
+        SPARSITYPATTERN,
+        VECTOR, DIM> OP;
+#undef TSP
+#undef DTSP
+
+typedef IntegratorDataContainer<DOFHANDLER, QUADRATURE,
+        FACEQUADRATURE, VECTOR, DIM> IDC;
+typedef Integrator<IDC, VECTOR, double, DIM> INTEGRATOR;
+typedef DirectLinearSolverWithMatrix<SPARSITYPATTERN, MATRIX, VECTOR> LINEARSOLVER;
+//The reference solution is computed by Newton's method.
+typedef InstatStepNewtonSolver<INTEGRATOR, LINEARSOLVER, VECTOR> NLS1;
+typedef InstatPDEProblem<NLS1, INTEGRATOR, OP, VECTOR, DIM> RP1;
+//The time steps are solved by the Anderson accelerated fixed-point
+//iteration of a splitting of the Jacobian instead of Newton's method.
+typedef InstatStepAndersonSolver<INTEGRATOR, LINEARSOLVER, VECTOR> NLS2;
+typedef InstatPDEProblem<NLS2, INTEGRATOR, OP, VECTOR, DIM> RP2;
+
+int
+main(int argc, char **argv)
+{
+  /**
+   * In this example we  solve the nonlinear, timedependent heat equation
+   * of Example5 with the Anderson accelerated fixed-point iteration
+   * and compare the result with Newton's method;
+   * see the documentation for more information.
+   */
+
+  dealii::Utilities::MPI::MPI_InitFinalize mpi(argc, argv);
+
+  string paramfile = "dope.prm";
+
+  if (argc == 2)
+    {
+      paramfile = argv[1];
+    }
+  else if (argc > 2)
+    {
+      std::cout << "Usage: " << argv[0] << " [ paramfile ] " << std::endl;
+      return -1;
+    }
+
+  //First, declare the parameters and read them in.
+  ParameterReader pr;
+  RP1::declare_params(pr);
+  RP2::declare_params(pr);
+  DOpEOutputHandler<VECTOR>::declare_params(pr);
+  pr.read_parameters(paramfile);
+
+  //Create the triangulation.
+  Triangulation<DIM> triangulation;
+  GridGenerator::hyper_cube(triangulation, 0., PI);
+
+  //Define the Finite Elements and quadrature formulas for the state.
+  FESystem<DIM> state_fe(FE_Q<DIM>(1), 1);
+
+  QGauss<DIM> quadrature_formula(3);
+  QGauss<DIM - 1> face_quadrature_formula(3);
+  IDC idc(quadrature_formula, face_quadrature_formula);
+
+  //Define the localPDEs and the functional we are interested in.
+  //The first one assembles the Jacobian for Newton's method, the second
+  //one the splitting without the derivative of the reaction term.
+  LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM> LPDE_newton;
+  LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM> LPDE_anderson(false);
+  LocalPointFunctional<EDC, FDC, DOFHANDLER, VECTOR, DIM, DIM> LPF;
+
+  //Time grid of [0,1]
+  Triangulation<1> times;
+  GridGenerator::subdivided_hyper_cube(times, 50);
+
+  triangulation.refine_global(4);
+  MethodOfLines_StateSpaceTimeHandler<FE, DOFHANDLER, SPARSITYPATTERN, VECTOR,
+                                      DIM> DOFH(triangulation, state_fe, times);
+
+  OP P1(LPDE_newton, DOFH);
+  OP P2(LPDE_anderson, DOFH);
+
+  P1.AddFunctional(&LPF);
+  P2.AddFunctional(&LPF);
+
+  std::vector<bool> comp_mask(1);
+  comp_mask[0] = true;
+
+  //Here we use zero boundary values
+  DOpEWrapper::ZeroFunction<DIM> zf;
+  SimpleDirichletData<VECTOR, DIM> DD1(zf);
+
+  P1.SetDirichletBoundaryColors(0, comp_mask, &DD1);
+  P2.SetDirichletBoundaryColors(0, comp_mask, &DD1);
+
+  //prepare the initial data
+  InitialData initial_data;
+  P1.SetInitialValues(&initial_data);
+  P2.SetInitialValues(&initial_data);
+
+  RP1 solver1(&P1, DOpEtypes::VectorStorageType::fullmem, pr, idc);
+  RP2 solver2(&P2, DOpEtypes::VectorStorageType::fullmem, pr, idc);
+
+  DOpEOutputHandler<VECTOR> out(&solver1, pr);
+  DOpEExceptionHandler<VECTOR> ex(&out);
+  P1.RegisterOutputHandler(&out);
+  P1.RegisterExceptionHandler(&ex);
+  P2.RegisterOutputHandler(&out);
+  P2.RegisterExceptionHandler(&ex);
+  solver1.RegisterOutputHandler(&out);
+  solver1.RegisterExceptionHandler(&ex);
+  solver2.RegisterOutputHandler(&out);
+  solver2.RegisterExceptionHandler(&ex);
+
+  try
+    {
+      //Before solving we have to reinitialize the stateproblem and outputhandler.
+      solver1.ReInit();
+      solver2.ReInit();
+      out.ReInit();
+
+      stringstream outp;
+      outp << "**************************************************\n";
+      outp << "*        Starting Forward Solve - Newton         *\n";
+      outp << "*   Solving : " << P1.GetName() << "\t*\n";
+      outp << "*   SDoFs   : ";
+      solver1.StateSizeInfo(outp);
+      outp << "**************************************************";
+      //We print this header with priority 1 and 1 empty line in front and after.
+      out.Write(outp, 1, 1, 1);
+
+      solver1.ComputeReducedFunctionals();
+
+      outp << "**************************************************\n";
+      outp << "*        Starting Forward Solve - Anderson       *\n";
+      outp << "*   Solving : " << P2.GetName() << "\t*\n";
+      outp << "*   SDoFs   : ";
+      solver2.StateSizeInfo(outp);
+      outp << "**************************************************";
+      out.Write(outp, 1, 1, 1);
+
+      solver2.ComputeReducedFunctionals();
+
+      //Both methods solve the same time steps up to the
+      //nonlinear tolerance.
+      SolutionExtractor<RP1, VECTOR> a1(solver1);
+      SolutionExtractor<RP2, VECTOR> a2(solver2);
+      const StateVector<VECTOR> &u_newton = a1.GetU();
+      SpaceTimeVector<VECTOR> difference(a2.GetU());
+      difference.equ(1., a2.GetU());
+      difference.add(-1., u_newton);
+      const double relative_difference = std::sqrt((difference * difference)
+                                                   / (u_newton * u_newton));
+
+      outp << "Anderson solution agrees with Newton solution: "
+           << ((relative_difference < 1.e-6) ? "yes" : "no");
+      out.Write(outp, 0, 1, 0);
+    }
+  catch (DOpEException &e)
+    {
+      std::cout
+          << "Warning: During execution of `" + e.GetThrowingInstance()
+          + "` the following Problem occurred!" << std::endl;
+      std::cout << e.GetErrorMessage() << std::endl;
+    }
+
+  return 0;
+}
+
+#undef FDC
+#undef EDC
+#undef FE
+#undef DOFHANDLER
@@ -35,6 +35,7 @@
 #include <iomanip>
 
 #include <include/parameterreader.h>
+#include <templates/newtonforcingterm.h>
 
 
 
@@ -161,14 +162,25 @@ namespace DOpE
     template<typename PROBLEM>
     void NonlinearLastTimeEvals(PROBLEM &pde, const VECTOR &last_time_solution, VECTOR &residual);
 
+    /**
+     * Returns the total number of Newton iterations done in NonlinearSolve
+     * since the construction of the solver.
+     */
+    unsigned int GetNIterations() const
+    {
+      return n_iterations_;
+    }
+
   protected:
 
     inline INTEGRATOR &GetIntegrator();
 
   private:
     INTEGRATOR &integrator_;
+    NewtonForcingTerm forcing_;
 
     bool build_matrix_;
+    unsigned int n_iterations_ = 0;
 
     double nonlinear_global_tol_, nonlinear_tol_, nonlinear_rho_;
     double linesearch_rho_;
@@ -190,6 +202,7 @@ namespace DOpE
     param_reader.declare_entry("line_maxiter", "4",Patterns::Integer(0),"maximal number of linesearch steps");
     param_reader.declare_entry("linesearch_rho", "0.9",Patterns::Double(0),"reduction rate for the linesearch damping paramete");
 
+    NewtonForcingTerm::declare_params(param_reader);
     LINEARSOLVER::declare_params(param_reader);
   }
 
@@ -198,7 +211,7 @@ namespace DOpE
   template <typename INTEGRATOR, typename LINEARSOLVER, typename VECTOR>
   InstatStepModifiedNewtonSolver<INTEGRATOR,LINEARSOLVER, VECTOR>
   ::InstatStepModifiedNewtonSolver(INTEGRATOR &integrator, ParameterReader &param_reader)
-    : LINEARSOLVER(param_reader), integrator_(integrator)
+    : LINEARSOLVER(param_reader), integrator_(integrator), forcing_(param_reader)
   {
     param_reader.SetSubsection("newtonsolver parameters");
     nonlinear_global_tol_ = param_reader.get_double ("nonlinear_global_tol");
@@ -294,6 +307,7 @@ namespace DOpE
     pde.GetOutputHandler()->Write(out,priority);
 
     int iter=0;
+    forcing_.Reset(std::max(nonlinear_global_tol_, firstres * nonlinear_tol_));
     while (res > nonlinear_global_tol_ && res > firstres * nonlinear_tol_)
       {
         iter++;
@@ -306,7 +320,7 @@ namespace DOpE
 
         pde.GetOutputHandler()->SetIterationNumber(iter,"PDENewton");
 
-        LINEARSOLVER::Solve(pde,GetIntegrator(),residual,du,build_matrix);
+        LINEARSOLVER::Solve(pde,GetIntegrator(),residual,du,build_matrix,forcing_.GetLinearTolerance());
 
         //Linesearch
         {
@@ -366,6 +380,7 @@ namespace DOpE
                 {
                   build_matrix=true;
                 }
+              forcing_.Update(res,lastres);
               lastres=res;
               res=newres;
 
@@ -461,6 +476,7 @@ namespace DOpE
 
 
     pde.GetOutputHandler()->Write(out,priority);
+    forcing_.Reset(std::max(nonlinear_global_tol_, firstres * nonlinear_tol_));
     while (res > nonlinear_global_tol_ && res > firstres * nonlinear_tol_)
       {
         iter++;
@@ -470,7 +486,7 @@ namespace DOpE
           }
 
         pde.GetOutputHandler()->SetIterationNumber(iter,"PDENewton");
-        LINEARSOLVER::Solve(pde,GetIntegrator(),residual,du,build_matrix);
+        LINEARSOLVER::Solve(pde,GetIntegrator(),residual,du,build_matrix,forcing_.GetLinearTolerance());
         //Linesearch
         {
           solution += du;
@@ -530,6 +546,7 @@ namespace DOpE
                 {
                   build_matrix=true;
                 }
+              forcing_.Update(res,lastres);
               lastres=res;
               res=newres;
 
@@ -544,7 +561,7 @@ namespace DOpE
     GetIntegrator().DeleteDomainData("last_time_solution");
     GetIntegrator().DeleteDomainData("last_newton_solution");
 
-
+    n_iterations_ += iter;
     return build_matrix;
   }
 
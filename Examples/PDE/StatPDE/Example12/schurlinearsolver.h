@@ -80,10 +80,11 @@ namespace DOpE
      *                              should be build by the linear solver in the first iteration.
      *            The default is false, meaning that if we have no idea we don't
      *            want to build a matrix.
+     * @param relative_tol          Ignored.
      *
      */
     template<typename PROBLEM, typename INTEGRATOR>
-    void Solve(PROBLEM &pde, INTEGRATOR &integr, dealii::BlockVector<double> &rhs, dealii::BlockVector<double> &solution, bool force_matrix_build=false);
+    void Solve(PROBLEM &pde, INTEGRATOR &integr, dealii::BlockVector<double> &rhs, dealii::BlockVector<double> &solution, bool force_matrix_build=false, double relative_tol=0.);
 
   protected:
 
@@ -194,7 +195,8 @@ namespace DOpE
                                           INTEGRATOR &integr,
                                           dealii::BlockVector<double> &rhs,
                                           dealii::BlockVector<double> &solution,
-                                          bool force_matrix_build)
+                                          bool force_matrix_build,
+                                          double /*relative_tol*/)
   {
     if (force_matrix_build)
       {
@@ -297,10 +299,11 @@ namespace DOpE
      *                              should be build by the linear solver in the first iteration.
      *            The default is false, meaning that if we have no idea we don't
      *            want to build a matrix.
+     * @param relative_tol          Ignored.
      *
      */
     template<typename PROBLEM, typename INTEGRATOR>
-    void Solve(PROBLEM &pde, INTEGRATOR &integr, dealii::BlockVector<double> &rhs, dealii::BlockVector<double> &solution, bool force_matrix_build=false);
+    void Solve(PROBLEM &pde, INTEGRATOR &integr, dealii::BlockVector<double> &rhs, dealii::BlockVector<double> &solution, bool force_matrix_build=false, double relative_tol=0.);
 
   protected:
 
@@ -392,7 +395,8 @@ namespace DOpE
                                           INTEGRATOR &integr,
                                           dealii::BlockVector<double> &rhs,
                                           dealii::BlockVector<double> &solution,
-                                          bool force_matrix_build)
+                                          bool force_matrix_build,
+                                          double /*relative_tol*/)
   {
     if (force_matrix_build)
       {
@@ -84,7 +84,8 @@ typedef SparsityPattern SPARSITYPATTERN;
 typedef Vector<double> VECTOR;
 
 //Second number denotes the number of unknowns per element (the blocksize we want to use)
-typedef DOpEWrapper::PreconditionBlockSSOR_Wrapper<MATRIX,4> PRECONDITIONERSSOR;
+//The element blocks are processed in downwind order, i.e., one sweep solves the system.
+typedef DOpEWrapper::PreconditionDownwindBlockSOR_Wrapper<MATRIX,4> PRECONDITIONERSSOR;
 
 typedef PDEProblemContainer<LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM>,
         SimpleDirichletData<VECTOR, DIM>, SPARSITYPATTERN, VECTOR, DIM> OP;
@@ -101,8 +101,8 @@ using PRECONDITIONERIDENTITYBLOCK =
   DOpEWrapper::PreconditionIdentity_Wrapper<MATRIXBLOCK>;
 using PRECONDITIONERIDENTITY =
   DOpEWrapper::PreconditionIdentity_Wrapper<MATRIX>;
-using PRECONDITIONERSSOR =
-  DOpEWrapper::PreconditionIdentity_Wrapper<MATRIX>; // TODO !!!
+using PRECONDITIONERAMG =
+  DOpEWrapper::PreconditionAMGElasticity_Wrapper<MATRIX, DIM>;
 
 // Define problemcontainer for block and non block
 typedef PDEProblemContainer<LocalPDE<EDC, FDC, DOFHANDLER, VECTORBLOCK, DIM>,
@@ -138,7 +138,8 @@ typedef Integrator<IDCBLOCK, VECTORBLOCK, double, DIM> BLOCKINTEGRATOR;
 typedef Integrator<IDC, VECTOR, double, DIM>           INTEGRATOR;
 
 // We set up three different linear solvers: Block and nonblock GMRES without
-// a preconditioner and an SSor preconditioned non-block GMRES
+// a preconditioner and a non-block GMRES preconditioned by algebraic multigrid
+// with the rigid body modes as near null space
 typedef GMRESLinearSolverWithMatrix<PRECONDITIONERIDENTITYBLOCK,
         SPARSITYPATTERNBLOCK,
         MATRIXBLOCK,
@@ -149,16 +150,16 @@ typedef GMRESLinearSolverWithMatrix<PRECONDITIONERIDENTITY,
         MATRIX,
         VECTOR>
         GMRESIDENTITY;
-typedef GMRESLinearSolverWithMatrix<PRECONDITIONERSSOR,
+typedef GMRESLinearSolverWithMatrix<PRECONDITIONERAMG,
         SPARSITYPATTERN,
         MATRIX,
         VECTOR>
-        GMRESSSOR;
+        GMRESAMG;
 
 // Define three newtonsolver fitting the three linear solvers
 typedef Parallel::NewtonSolver<BLOCKINTEGRATOR, GMRESIDENTITYBLOCK, VECTORBLOCK> NLS1;
 typedef Parallel::NewtonSolver<INTEGRATOR, GMRESIDENTITY, VECTOR>                NLS2;
-typedef Parallel::NewtonSolver<INTEGRATOR, GMRESSSOR, VECTOR>                    NLS3;
+typedef Parallel::NewtonSolver<INTEGRATOR, GMRESAMG, VECTOR>                     NLS3;
 
 // Define the three ssolver fitting the three linear solvers.
 typedef StatPDEProblem<NLS1, BLOCKINTEGRATOR, OPBLOCK, VECTORBLOCK, DIM> RP1;
@@ -324,7 +325,7 @@ main(int argc, char **argv)
       }
   }
   // Here we solve with nonpreconditioned GMRES without blockstructure as
-  // well as with the SSOR preconditioned GMRES.
+  // well as with the AMG preconditioned GMRES.
   {
     RP2 solver2(&P, DOpEtypes::VectorStorageType::fullmem, pr, idc);
     RP3 solver3(&P, DOpEtypes::VectorStorageType::fullmem, pr, idc);
@@ -362,7 +363,7 @@ main(int argc, char **argv)
             solver2.ComputeReducedFunctionals();
 
             outp << "**************************************************\n";
-            outp << "*             Starting Forward Solve - 3         *\n";
+            outp << "*          Starting Forward Solve - 3 (AMG)      *\n";
             outp << "*   Solving : " << P.GetName() << "\t*\n";
             outp << "*   SDoFs   : ";
             solver3.StateSizeInfo(outp);
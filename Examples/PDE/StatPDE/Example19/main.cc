@@ -0,0 +1,206 @@
+/**
+ *
+ * Copyright (C) 2012-2018 by the DOpElib authors
+ *
+ * This file is part of DOpElib
+ *
+ * DOpElib is free software: you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * DOpElib is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * Please refer to the file LICENSE.TXT included in this distribution
+ * for further information on this license.
+ *
+ **/
+#include <iostream>
+#include <fstream>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <container/pdeproblemcontainer.h>
+#include <reducedproblems/statpdeproblem.h>
+#include <templates/newtonsolver.h>
+#include <templates/jfnk_newtonsolver.h>
+#include <templates/directlinearsolver.h>
+#include <templates/integrator.h>
+#include <include/parameterreader.h>
+#include <basic/mol_statespacetimehandler.h>
+#include <problemdata/simpledirichletdata.h>
+#include <container/integratordatacontainer.h>
+
+#include "localpde.h"
+#include "functionals.h"
+
+using namespace std;
+using namespace dealii;
+using namespace DOpE;
+
+const static int DIM = 2;
+
+#if DEAL_II_VERSION_GTE(9,3,0)
+#define DOFHANDLER false
+#else
+#define DOFHANDLER DoFHandler
+#endif
+
+#define FE FESystem
+#define EDC ElementDataContainer
+#define FDC FaceDataContainer
+
+typedef QGauss<DIM> QUADRATURE;
+typedef QGauss<DIM - 1> FACEQUADRATURE;
+typedef SparseMatrix<double> MATRIX;
+typedef SparsityPattern SPARSITYPATTERN;
+typedef Vector<double> VECTOR;
+
+typedef PDEProblemContainer<LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM>,
+        SimpleDirichletData<VECTOR, DIM>, SPARSITYPATTERN, VECTOR, DIM> OP;
+typedef IntegratorDataContainer<DOFHANDLER, QUADRATURE, FACEQUADRATURE, VECTOR,
+        DIM> IDC;
+typedef Integrator<IDC, VECTOR, double, DIM> INTEGRATOR;
+typedef DirectLinearSolverWithMatrix<SPARSITYPATTERN, MATRIX, VECTOR> LINEARSOLVER;
+//The reference solution is computed by the usual Newton method...
+typedef NewtonSolver<INTEGRATOR, LINEARSOLVER, VECTOR> NLS;
+typedef StatPDEProblem<NLS, INTEGRATOR, OP, VECTOR, DIM> RP;
+//...and compared to the Jacobian-free Newton-Krylov method, which uses the
+//direct solver only as preconditioner.
+typedef JFNKNewtonSolver<INTEGRATOR, LINEARSOLVER, VECTOR> JFNKNLS;
+typedef StatPDEProblem<JFNKNLS, INTEGRATOR, OP, VECTOR, DIM> RPJFNK;
+typedef MethodOfLines_StateSpaceTimeHandler<FE, DOFHANDLER, SPARSITYPATTERN,
+        VECTOR, DIM> STH;
+
+int
+main(int argc, char **argv)
+{
+  /**
+   *  Solving the nonlinear equation -\Delta u + u^3 = 50 in 2d
+   *  with zero dirichlet values by the Newton method and
+   *  by the Jacobian-free Newton-Krylov method.
+   */
+
+  dealii::Utilities::MPI::MPI_InitFinalize mpi(argc, argv);
+
+  string paramfile = "dope.prm";
+
+  if (argc == 2)
+    {
+      paramfile = argv[1];
+    }
+  else if (argc > 2)
+    {
+      std::cout << "Usage: " << argv[0] << " [ paramfile ] " << std::endl;
+      return -1;
+    }
+
+  ParameterReader pr;
+  RP::declare_params(pr);
+  RPJFNK::declare_params(pr);
+  DOpEOutputHandler<VECTOR>::declare_params(pr);
+  pr.read_parameters(paramfile);
+
+  Triangulation<DIM> triangulation;
+
+  FE<DIM> state_fe(FE_Q<DIM>(1), 1);
+
+  QUADRATURE quadrature_formula(3);
+  FACEQUADRATURE face_quadrature_formula(3);
+  IDC idc(quadrature_formula, face_quadrature_formula);
+
+  LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM> LPDE;
+
+  LocalPointFunctional<EDC, FDC, DOFHANDLER, VECTOR, DIM> LPF;
+
+  // Spatial grid
+  GridGenerator::hyper_cube(triangulation, 0, 1);
+  triangulation.refine_global(5);
+
+  STH DOFH(triangulation, state_fe);
+
+  OP P(LPDE, DOFH);
+
+  P.AddFunctional(&LPF);
+
+  std::vector<bool> comp_mask(1, true);
+
+  DOpEWrapper::ZeroFunction<DIM> zf(1);
+  SimpleDirichletData<VECTOR, DIM> DD1(zf);
+
+  P.SetDirichletBoundaryColors(0, comp_mask, &DD1);
+
+  RP solver(&P, DOpEtypes::VectorStorageType::fullmem, pr, idc);
+  RPJFNK solver_jfnk(&P, DOpEtypes::VectorStorageType::fullmem, pr, idc);
+  //Only needed for pure PDE Problems
+  DOpEOutputHandler<VECTOR> out(&solver, pr);
+  DOpEExceptionHandler<VECTOR> ex(&out);
+  P.RegisterOutputHandler(&out);
+  P.RegisterExceptionHandler(&ex);
+  solver.RegisterOutputHandler(&out);
+  solver.RegisterExceptionHandler(&ex);
+  solver_jfnk.RegisterOutputHandler(&out);
+  solver_jfnk.RegisterExceptionHandler(&ex);
+
+  try
+    {
+      solver.ReInit();
+      solver_jfnk.ReInit();
+      out.ReInit();
+      stringstream outp;
+
+      outp << "**************************************************\n";
+      outp << "*             Starting Forward Solve - Newton    *\n";
+      outp << "*   Solving : " << P.GetName() << "\t*\n";
+      outp << "*   SDoFs   : ";
+      solver.StateSizeInfo(outp);
+      outp << "**************************************************";
+      out.Write(outp, 1, 1, 1);
+
+      solver.ComputeReducedFunctionals();
+
+      outp << "**************************************************\n";
+      outp << "*             Starting Forward Solve - JFNK      *\n";
+      outp << "*   Solving : " << P.GetName() << "\t*\n";
+      outp << "*   SDoFs   : ";
+      solver_jfnk.StateSizeInfo(outp);
+      outp << "**************************************************";
+      out.Write(outp, 1, 1, 1);
+
+      solver_jfnk.ComputeReducedFunctionals();
+
+      //Both methods solve the same discrete problem up to the
+      //nonlinear tolerance.
+      SolutionExtractor<RP, VECTOR> a1(solver);
+      SolutionExtractor<RPJFNK, VECTOR> a2(solver_jfnk);
+      const VECTOR &u_newton = a1.GetU().GetSpacialVector();
+      VECTOR difference = a2.GetU().GetSpacialVector();
+      difference -= u_newton;
+      const double relative_difference = difference.l2_norm() / u_newton.l2_norm();
+
+      outp << "JFNK solution agrees with Newton solution: "
+           << ((relative_difference < 1.e-6) ? "yes" : "no");
+      out.Write(outp, 0, 1, 0);
+    }
+  catch (DOpEException &e)
+    {
+      std::cout
+          << "Warning: During execution of `" + e.GetThrowingInstance()
+          + "` the following Problem occurred!" << std::endl;
+      std::cout << e.GetErrorMessage() << std::endl;
+    }
+
+  return 0;
+}
+#undef FDC
+#undef EDC
+#undef FE
+#undef DOFHANDLER
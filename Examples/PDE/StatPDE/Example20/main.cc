@@ -0,0 +1,202 @@
+/**
+ *
+ * Copyright (C) 2012-2018 by the DOpElib authors
+ *
+ * This file is part of DOpElib
+ *
+ * DOpElib is free software: you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * DOpElib is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * Please refer to the file LICENSE.TXT included in this distribution
+ * for further information on this license.
+ *
+ **/
+#include <iostream>
+#include <fstream>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <container/pdeproblemcontainer.h>
+#include <reducedproblems/statpdeproblem.h>
+#include <templates/newtonsolver.h>
+#include <templates/directlinearsolver.h>
+#include <templates/mixedprecisiondirectlinearsolver.h>
+#include <templates/integrator.h>
+#include <include/parameterreader.h>
+#include <basic/mol_statespacetimehandler.h>
+#include <problemdata/simpledirichletdata.h>
+#include <container/integratordatacontainer.h>
+
+#include "localpde.h"
+
+using namespace std;
+using namespace dealii;
+using namespace DOpE;
+
+const static int DIM = 2;
+
+#if DEAL_II_VERSION_GTE(9,3,0)
+#define DOFHANDLER false
+#else
+#define DOFHANDLER DoFHandler
+#endif
+
+#define FE FESystem
+#define EDC ElementDataContainer
+#define FDC FaceDataContainer
+
+typedef QGauss<DIM> QUADRATURE;
+typedef QGauss<DIM - 1> FACEQUADRATURE;
+typedef SparseMatrix<double> MATRIX;
+typedef SparsityPattern SPARSITYPATTERN;
+typedef Vector<double> VECTOR;
+
+typedef PDEProblemContainer<LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM>,
+        SimpleDirichletData<VECTOR, DIM>, SPARSITYPATTERN, VECTOR, DIM> OP;
+typedef IntegratorDataContainer<DOFHANDLER, QUADRATURE, FACEQUADRATURE, VECTOR,
+        DIM> IDC;
+typedef Integrator<IDC, VECTOR, double, DIM> INTEGRATOR;
+//The reference solution is computed with the double precision factorization
+//of UMFPACK...
+typedef DirectLinearSolverWithMatrix<SPARSITYPATTERN, MATRIX, VECTOR> LINEARSOLVER;
+typedef NewtonSolver<INTEGRATOR, LINEARSOLVER, VECTOR> NLS;
+typedef StatPDEProblem<NLS, INTEGRATOR, OP, VECTOR, DIM> RP;
+//...and compared to the single precision factorization with iterative refinement.
+typedef MixedPrecisionDirectLinearSolverWithMatrix<SPARSITYPATTERN, MATRIX, VECTOR> MPLINEARSOLVER;
+typedef NewtonSolver<INTEGRATOR, MPLINEARSOLVER, VECTOR> MPNLS;
+typedef StatPDEProblem<MPNLS, INTEGRATOR, OP, VECTOR, DIM> RPMP;
+typedef MethodOfLines_StateSpaceTimeHandler<FE, DOFHANDLER, SPARSITYPATTERN,
+        VECTOR, DIM> STH;
+
+int
+main(int argc, char **argv)
+{
+  /**
+   *  Solving the convection-diffusion-reaction equation
+   *  -\Delta u + b \cdot \nabla u + u = 1 in 2d with zero dirichlet values
+   *  with a double precision and with a mixed precision direct solver.
+   */
+
+  dealii::Utilities::MPI::MPI_InitFinalize mpi(argc, argv);
+
+  string paramfile = "dope.prm";
+
+  if (argc == 2)
+    {
+      paramfile = argv[1];
+    }
+  else if (argc > 2)
+    {
+      std::cout << "Usage: " << argv[0] << " [ paramfile ] " << std::endl;
+      return -1;
+    }
+
+  ParameterReader pr;
+  RP::declare_params(pr);
+  RPMP::declare_params(pr);
+  DOpEOutputHandler<VECTOR>::declare_params(pr);
+  pr.read_parameters(paramfile);
+
+  Triangulation<DIM> triangulation;
+
+  FE<DIM> state_fe(FE_Q<DIM>(2), 1);
+
+  QUADRATURE quadrature_formula(3);
+  FACEQUADRATURE face_quadrature_formula(3);
+  IDC idc(quadrature_formula, face_quadrature_formula);
+
+  LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM> LPDE;
+
+  // Spatial grid
+  GridGenerator::hyper_cube(triangulation, 0, 1);
+  triangulation.refine_global(5);
+
+  STH DOFH(triangulation, state_fe);
+
+  OP P(LPDE, DOFH);
+
+  std::vector<bool> comp_mask(1, true);
+
+  DOpEWrapper::ZeroFunction<DIM> zf(1);
+  SimpleDirichletData<VECTOR, DIM> DD1(zf);
+
+  P.SetDirichletBoundaryColors(0, comp_mask, &DD1);
+
+  RP solver(&P, DOpEtypes::VectorStorageType::fullmem, pr, idc);
+  RPMP solver_mp(&P, DOpEtypes::VectorStorageType::fullmem, pr, idc);
+  //Only needed for pure PDE Problems
+  DOpEOutputHandler<VECTOR> out(&solver, pr);
+  DOpEExceptionHandler<VECTOR> ex(&out);
+  P.RegisterOutputHandler(&out);
+  P.RegisterExceptionHandler(&ex);
+  solver.RegisterOutputHandler(&out);
+  solver.RegisterExceptionHandler(&ex);
+  solver_mp.RegisterOutputHandler(&out);
+  solver_mp.RegisterExceptionHandler(&ex);
+
+  try
+    {
+      solver.ReInit();
+      solver_mp.ReInit();
+      out.ReInit();
+      stringstream outp;
+
+      outp << "**************************************************\n";
+      outp << "*      Starting Forward Solve - Double Precision *\n";
+      outp << "*   Solving : " << P.GetName() << "\t*\n";
+      outp << "*   SDoFs   : ";
+      solver.StateSizeInfo(outp);
+      outp << "**************************************************";
+      out.Write(outp, 1, 1, 1);
+
+      solver.ComputeReducedFunctionals();
+
+      outp << "**************************************************\n";
+      outp << "*      Starting Forward Solve - Mixed Precision  *\n";
+      outp << "*   Solving : " << P.GetName() << "\t*\n";
+      outp << "*   SDoFs   : ";
+      solver_mp.StateSizeInfo(outp);
+      outp << "**************************************************";
+      out.Write(outp, 1, 1, 1);
+
+      solver_mp.ComputeReducedFunctionals();
+
+      //Without the iterative refinement the solution computed with the
+      //single precision factors has only about seven correct digits.
+      SolutionExtractor<RP, VECTOR> a1(solver);
+      SolutionExtractor<RPMP, VECTOR> a2(solver_mp);
+      const VECTOR &u_double = a1.GetU().GetSpacialVector();
+      VECTOR difference = a2.GetU().GetSpacialVector();
+      difference -= u_double;
+      const double relative_difference = difference.l2_norm() / u_double.l2_norm();
+
+      outp << "Mixed precision solution agrees with double precision solution: "
+           << ((relative_difference < 1.e-8) ? "yes" : "no");
+      out.Write(outp, 0, 1, 0);
+    }
+  catch (DOpEException &e)
+    {
+      std::cout
+          << "Warning: During execution of `" + e.GetThrowingInstance()
+          + "` the following Problem occurred!" << std::endl;
+      std::cout << e.GetErrorMessage() << std::endl;
+    }
+
+  return 0;
+}
+#undef FDC
+#undef EDC
+#undef FE
+#undef DOFHANDLER
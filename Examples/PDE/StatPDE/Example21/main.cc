@@ -0,0 +1,254 @@
+/**
+ *
+ * Copyright (C) 2012-2018 by the DOpElib authors
+ *
+ * This file is part of DOpElib
+ *
+ * DOpElib is free software: you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * DOpElib is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * Please refer to the file LICENSE.TXT included in this distribution
+ * for further information on this license.
+ *
+ **/
+#include <iostream>
+#include <fstream>
+#include <cmath>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <container/pdeproblemcontainer.h>
+#include <reducedproblems/statpdeproblem.h>
+#include <templates/newtonsolver.h>
+#include <templates/directlinearsolver.h>
+#include <templates/gmreslinearsolver.h>
+#include <wrapper/preconditioner_wrapper.h>
+#include <templates/integrator.h>
+#include <include/parameterreader.h>
+#include <basic/mol_statespacetimehandler.h>
+#include <problemdata/simpledirichletdata.h>
+#include <container/integratordatacontainer.h>
+
+#include "localpde.h"
+
+using namespace std;
+using namespace dealii;
+using namespace DOpE;
+
+const static int DIM = 2;
+
+#if DEAL_II_VERSION_GTE(9,3,0)
+#define DOFHANDLER false
+#else
+#define DOFHANDLER DoFHandler
+#endif
+
+#define FE FESystem
+#define EDC ElementDataContainer
+#define FDC FaceDataContainer
+
+typedef QGauss<DIM> QUADRATURE;
+typedef QGauss<DIM - 1> FACEQUADRATURE;
+typedef SparseMatrix<double> MATRIX;
+typedef SparsityPattern SPARSITYPATTERN;
+typedef Vector<double> VECTOR;
+
+typedef PDEProblemContainer<LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM>,
+        SimpleDirichletData<VECTOR, DIM>, SPARSITYPATTERN, VECTOR, DIM> OP;
+typedef IntegratorDataContainer<DOFHANDLER, QUADRATURE, FACEQUADRATURE, VECTOR,
+        DIM> IDC;
+typedef Integrator<IDC, VECTOR, double, DIM> INTEGRATOR;
+//The reference solution is computed with UMFPACK...
+typedef DirectLinearSolverWithMatrix<SPARSITYPATTERN, MATRIX, VECTOR> LINEARSOLVER;
+typedef NewtonSolver<INTEGRATOR, LINEARSOLVER, VECTOR> NLS;
+typedef StatPDEProblem<NLS, INTEGRATOR, OP, VECTOR, DIM> RP;
+//...and compared to GMRES preconditioned by the additive Schwarz method.
+typedef DOpEWrapper::PreconditionAdditiveSchwarz_Wrapper<MATRIX> SCHWARZ;
+typedef GMRESLinearSolverWithMatrix<SCHWARZ, SPARSITYPATTERN, MATRIX, VECTOR> GMRESLINEARSOLVER;
+typedef NewtonSolver<INTEGRATOR, GMRESLINEARSOLVER, VECTOR> GMRESNLS;
+typedef StatPDEProblem<GMRESNLS, INTEGRATOR, OP, VECTOR, DIM> RPGMRES;
+typedef MethodOfLines_StateSpaceTimeHandler<FE, DOFHANDLER, SPARSITYPATTERN,
+        VECTOR, DIM> STH;
+
+/**
+ * Checks (P^{-T}x,y) = (x,P^{-1}y) for the additive Schwarz preconditioner
+ * of the 1d upwind discretization of -u'' + 20 u' on n points, whose
+ * local problems are not symmetric.
+ */
+double
+SchwarzTransposeDefect(unsigned int n)
+{
+  DynamicSparsityPattern dsp(n, n);
+  for (unsigned int i = 0; i < n; i++)
+    {
+      dsp.add(i, i);
+      if (i > 0)
+        dsp.add(i, i - 1);
+      if (i + 1 < n)
+        dsp.add(i, i + 1);
+    }
+  SparsityPattern sparsity;
+  sparsity.copy_from(dsp);
+  MATRIX A(sparsity);
+  const double h = 1. / (n + 1);
+  for (unsigned int i = 0; i < n; i++)
+    {
+      A.set(i, i, 2. / (h * h) + 20. / h);
+      if (i > 0)
+        A.set(i, i - 1, -1. / (h * h) - 20. / h);
+      if (i + 1 < n)
+        A.set(i, i + 1, -1. / (h * h));
+    }
+
+  SCHWARZ precondition;
+  precondition.SetNumberOfPatches(4);
+  precondition.initialize(A);
+
+  VECTOR x(n), y(n), px(n), py(n);
+  for (unsigned int i = 0; i < n; i++)
+    {
+      x(i) = std::sin(1. + i);
+      y(i) = std::cos(2. * i);
+    }
+  precondition.Tvmult(px, x);
+  precondition.vmult(py, y);
+  return std::fabs(px * y - x * py) / (px.l2_norm() * y.l2_norm());
+}
+
+int
+main(int argc, char **argv)
+{
+  /**
+   *  Solving the convection-diffusion-reaction equation
+   *  -\Delta u + b \cdot \nabla u + u = 1 in 2d with zero dirichlet values
+   *  with a direct solver and with GMRES preconditioned by the
+   *  additive Schwarz method.
+   */
+
+  dealii::Utilities::MPI::MPI_InitFinalize mpi(argc, argv);
+
+  string paramfile = "dope.prm";
+
+  if (argc == 2)
+    {
+      paramfile = argv[1];
+    }
+  else if (argc > 2)
+    {
+      std::cout << "Usage: " << argv[0] << " [ paramfile ] " << std::endl;
+      return -1;
+    }
+
+  ParameterReader pr;
+  RP::declare_params(pr);
+  RPGMRES::declare_params(pr);
+  DOpEOutputHandler<VECTOR>::declare_params(pr);
+  pr.read_parameters(paramfile);
+
+  Triangulation<DIM> triangulation;
+
+  FE<DIM> state_fe(FE_Q<DIM>(2), 1);
+
+  QUADRATURE quadrature_formula(3);
+  FACEQUADRATURE face_quadrature_formula(3);
+  IDC idc(quadrature_formula, face_quadrature_formula);
+
+  LocalPDE<EDC, FDC, DOFHANDLER, VECTOR, DIM> LPDE;
+
+  // Spatial grid
+  GridGenerator::hyper_cube(triangulation, 0, 1);
+  triangulation.refine_global(5);
+
+  STH DOFH(triangulation, state_fe);
+
+  OP P(LPDE, DOFH);
+
+  std::vector<bool> comp_mask(1, true);
+
+  DOpEWrapper::ZeroFunction<DIM> zf(1);
+  SimpleDirichletData<VECTOR, DIM> DD1(zf);
+
+  P.SetDirichletBoundaryColors(0, comp_mask, &DD1);
+
+  RP solver(&P, DOpEtypes::VectorStorageType::fullmem, pr, idc);
+  RPGMRES solver_gmres(&P, DOpEtypes::VectorStorageType::fullmem, pr, idc);
+  //Only needed for pure PDE Problems
+  DOpEOutputHandler<VECTOR> out(&solver, pr);
+  DOpEExceptionHandler<VECTOR> ex(&out);
+  P.RegisterOutputHandler(&out);
+  P.RegisterExceptionHandler(&ex);
+  solver.RegisterOutputHandler(&out);
+  solver.RegisterExceptionHandler(&ex);
+  solver_gmres.RegisterOutputHandler(&out);
+  solver_gmres.RegisterExceptionHandler(&ex);
+
+  try
+    {
+      solver.ReInit();
+      solver_gmres.ReInit();
+      out.ReInit();
+      stringstream outp;
+
+      outp << "**************************************************\n";
+      outp << "*      Starting Forward Solve - Direct Solver    *\n";
+      outp << "*   Solving : " << P.GetName() << "\t*\n";
+      outp << "*   SDoFs   : ";
+      solver.StateSizeInfo(outp);
+      outp << "**************************************************";
+      out.Write(outp, 1, 1, 1);
+
+      solver.ComputeReducedFunctionals();
+
+      outp << "**************************************************\n";
+      outp << "*      Starting Forward Solve - Schwarz GMRES    *\n";
+      outp << "*   Solving : " << P.GetName() << "\t*\n";
+      outp << "*   SDoFs   : ";
+      solver_gmres.StateSizeInfo(outp);
+      outp << "**************************************************";
+      out.Write(outp, 1, 1, 1);
+
+      solver_gmres.ComputeReducedFunctionals();
+
+      SolutionExtractor<RP, VECTOR> a1(solver);
+      SolutionExtractor<RPGMRES, VECTOR> a2(solver_gmres);
+      const VECTOR &u_direct = a1.GetU().GetSpacialVector();
+      VECTOR difference = a2.GetU().GetSpacialVector();
+      difference -= u_direct;
+      const double relative_difference = difference.l2_norm() / u_direct.l2_norm();
+
+      outp << "GMRES solution agrees with direct solution: "
+           << ((relative_difference < 1.e-6) ? "yes" : "no");
+      out.Write(outp, 0, 1, 0);
+
+      //GMRES only applies vmult, the transposed application
+      //is checked separately.
+      outp << "Transposed Schwarz preconditioner agrees with adjoint: "
+           << ((SchwarzTransposeDefect(400) < 1.e-10) ? "yes" : "no");
+      out.Write(outp, 0, 0, 0);
+    }
+  catch (DOpEException &e)
+    {
+      std::cout
+          << "Warning: During execution of `" + e.GetThrowingInstance()
+          + "` the following Problem occurred!" << std::endl;
+      std::cout << e.GetErrorMessage() << std::endl;
+    }
+
+  return 0;
+}
+#undef FDC
+#undef EDC
+#undef FE
+#undef DOFHANDLER